@@ -0,0 +1,118 @@
+/**
+ * @file arrival_ring.h
+ * @brief The arriving processes go from the generator to the scheduler through
+ * a single producer single consumer ring in shared memory. The generator
+ * writes a tick's arrivals into the free slots and publishes them with one
+ * store of the head, the scheduler reads every published one in place and
+ * frees them with one store of the tail. No syscall, no lock.
+ * Both the generator and the scheduler include it after headers.h.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#ifndef _ARRIVAL_RING_H
+#define _ARRIVAL_RING_H
+
+#include "process_generator.h"
+
+// Arrival ring shared memory key
+#define ARRIVAL_SHKEY 303
+
+#define ARRIVAL_RING_SIZE 65536 /**< a power of 2, the arrivals that don't fit wait for the next tick */
+
+/**
+ * @brief Layout of the arrival ring shared memory. head and tail only grow,
+ * they wrap around the unsigned range and the slot is the index modulo the
+ * size. Each is written by one side only and sits on its own cache line.
+ */
+typedef struct
+{
+    unsigned head __attribute__((aligned(64))); /**< published up to here, written by the generator */
+    int maxOccupancy;     /**< the most arrivals in the ring after a publish */
+    int fullTicks;        /**< the ticks the generator held arrivals back because the ring was full */
+
+    unsigned tail __attribute__((aligned(64))); /**< read up to here, written by the scheduler */
+    int drains;           /**< the ticks that drained at least one arrival */
+    long long delivered;
+    int maxDelivered;
+
+    process_t procs[ARRIVAL_RING_SIZE] __attribute__((aligned(64)));
+} arrival_ring_t;
+
+/*
+ * Attach to the arrival ring shared memory, the generator creates it.
+*/
+arrival_ring_t *attachArrivalRing(int create, int *shmid)
+{
+    *shmid = shmget(ARRIVAL_SHKEY, sizeof(arrival_ring_t), create ? IPC_CREAT | 0644 : 0644);
+    if (*shmid == -1)
+    {
+        perror("Failed to get the arrival ring shared memory");
+        exit(EXIT_FAILURE);
+    }
+
+    arrival_ring_t *ring = (arrival_ring_t *) shmat(*shmid, (void *)0, 0);
+    if ((long)ring == -1)
+    {
+        perror("Failed to attach the arrival ring shared memory");
+        exit(EXIT_FAILURE);
+    }
+    return ring;
+}
+
+/*
+ * The slot of the index-th process that went through the ring.
+*/
+process_t *arrivalSlot(arrival_ring_t *ring, unsigned index)
+{
+    return &ring->procs[index & (ARRIVAL_RING_SIZE - 1)];
+}
+
+/*
+ * How many processes the generator can write past the head, see arrivalSlot().
+ * Only the generator calls it.
+*/
+int arrivalRingFree(arrival_ring_t *ring)
+{
+    return ARRIVAL_RING_SIZE - (int)(ring->head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE));
+}
+
+/*
+ * Make the n processes written past the head visible to the scheduler at once.
+*/
+void arrivalRingPublish(arrival_ring_t *ring, int n)
+{
+    __atomic_store_n(&ring->head, ring->head + n, __ATOMIC_RELEASE);
+
+    int occupancy = ARRIVAL_RING_SIZE - arrivalRingFree(ring);
+    if (occupancy > ring->maxOccupancy)
+        ring->maxOccupancy = occupancy;
+}
+
+/*
+ * How many published processes the scheduler can read from the tail on.
+ * Only the scheduler calls it.
+*/
+int arrivalRingCount(arrival_ring_t *ring)
+{
+    return (int)(__atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) - ring->tail);
+}
+
+/*
+ * Give the n processes read from the tail on back to the generator, and count
+ * them as the current tick's arrivals.
+*/
+void arrivalRingRelease(arrival_ring_t *ring, int n)
+{
+    __atomic_store_n(&ring->tail, ring->tail + n, __ATOMIC_RELEASE);
+
+    if (n == 0)
+        return;
+
+    ring->drains++;
+    ring->delivered += n;
+    if (n > ring->maxDelivered)
+        ring->maxDelivered = n;
+}
+
+#endif /* _ARRIVAL_RING_H */
@@ -0,0 +1,70 @@
+/**
+ * @file bucket_queue.c
+ * @brief A FIFO per key and an occupancy bitmap for small integer keys.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#include <stdlib.h>
+#include "bucket_queue.h"
+
+/**
+ * @param bucketCapacity the capacity of every key's FIFO
+ */
+struct BucketQueue *CreateBucketQueue(unsigned bucketCapacity)
+{
+        struct BucketQueue *bq = (struct BucketQueue *)calloc(1, sizeof(struct BucketQueue));
+        bq->bucketCapacity = bucketCapacity;
+        return bq;
+}
+
+/**
+ * @brief 1 if the key has a bucket, the others have to go somewhere else
+ */
+int BucketKeyFits(int key)
+{
+        return key >= 0 && key < BUCKET_KEYS;
+}
+
+int BucketIsEmpty(struct BucketQueue *bq)
+{
+        return bq->occupied == 0;
+}
+
+/**
+ * @brief The smallest key that has PCBs, the queue mustn't be empty
+ */
+int BucketMinKey(struct BucketQueue *bq)
+{
+        return __builtin_ctzll(bq->occupied);
+}
+
+/**
+ * @brief Add a PCB at the back of its key's FIFO
+ * @param key the key, BucketKeyFits() has to be true for it
+ */
+void BucketInsert(struct BucketQueue *bq, PCB *pcb, int key)
+{
+        if (bq->buckets[key] == NULL)
+                bq->buckets[key] = CreateQueue(bq->bucketCapacity);
+
+        Enqueue(bq->buckets[key], pcb);
+        bq->occupied |= 1ULL << key;
+        bq->size++;
+}
+
+/**
+ * @brief Remove and return the first PCB of the smallest key, NULL if it's empty
+ */
+PCB *BucketExtractMin(struct BucketQueue *bq)
+{
+        if (bq->occupied == 0)
+                return NULL;
+
+        int key = BucketMinKey(bq);
+        PCB *pcb = Dequeue(bq->buckets[key]);
+        if (IsEmpty(bq->buckets[key]))
+                bq->occupied &= ~(1ULL << key);
+        bq->size--;
+        return pcb;
+}
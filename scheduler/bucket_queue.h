@@ -0,0 +1,33 @@
+/**
+ * @file bucket_queue.h
+ * @brief A priority queue for small integer keys: a FIFO per key and a bitmap
+ * of the keys that have PCBs, the smallest one is found with find first set.
+ * Inserting and extracting are O(1) and equal keys come out in arrival order.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#ifndef _BUCKET_QUEUE_H
+#define _BUCKET_QUEUE_H
+
+#include <stdint.h>
+#include "ready_queue.h"
+
+#define BUCKET_KEYS 64 /**< the keys are 0 to BUCKET_KEYS - 1, one bit each */
+
+struct BucketQueue
+{
+        uint64_t occupied;                   /**< bit k is set if buckets[k] has PCBs */
+        struct Queue *buckets[BUCKET_KEYS];  /**< created on their first PCB */
+        unsigned bucketCapacity;
+        int size;
+};
+
+struct BucketQueue *CreateBucketQueue(unsigned bucketCapacity);
+int BucketKeyFits(int key);
+int BucketIsEmpty(struct BucketQueue *bq);
+int BucketMinKey(struct BucketQueue *bq);
+void BucketInsert(struct BucketQueue *bq, PCB *pcb, int key);
+PCB *BucketExtractMin(struct BucketQueue *bq);
+
+#endif /* _BUCKET_QUEUE_H */
@@ -235,6 +235,35 @@ void Deallocate(node *root)
         treeRoot = NULL;
 }
 
+/**
+ * @brief The size of the largest free piece of memory under a node. A leaf
+ * is allocated, a missing child is free.
+ * 
+ * @param root the node
+ * @return int the size of the largest free piece, 0 if there's none
+ */
+int largestFree(node *root)
+{
+    if (root->left == NULL && root->right == NULL)
+        return 0;
+
+    int left = root->left == NULL ? root->data / 2 : largestFree(root->left);
+    int right = root->right == NULL ? root->data / 2 : largestFree(root->right);
+    return left > right ? left : right;
+}
+
+/**
+ * @brief The size of the largest piece of memory that can be allocated.
+ * 
+ * @return int the size of the largest free piece, 0 if the memory is full
+ */
+int LargestFreeBlock()
+{
+    if (treeRoot == NULL)
+        return MEM_MAX_SIZE;
+    return largestFree(treeRoot);
+}
+
 /**
  * @brief traverse a binary tree in a preorder way to print its leaves that
  * represent the memory allocated.
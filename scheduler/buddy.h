@@ -33,6 +33,7 @@ node *newNode(int data, node *parent, int start);
 node *Allocate(int size);
 void Deallocate(node *root);
 void PreorderTraverse(node *root);
+int LargestFreeBlock();
 
 #endif /* _BUDDY_H_ */
 
@@ -5,13 +5,23 @@
  * It is not a real part of operating system!
  */
 
+#include <string.h>
+#include <stdint.h>
 #include "headers.h"
 
 int shmid;
+int tickFd = -1; // an eventfd the scheduler polls, written on every tick
+
+void Tick(int tick);
+
+int NextVirtualTick(clk_shm_t *shm);
+void PrintBarrierStats(clk_shm_t *shm);
 
 /* Clear the resources before exit */
 void cleanup(int signum)
 {
+    if (clkShm != NULL)
+        PrintBarrierStats(clkShm);
     shmctl(shmid, IPC_RMID, NULL);
     printf("Clock terminating!\n");
     exit(0);
@@ -23,23 +33,134 @@ int main(int argc, char * argv[])
     printf("Clock starting\n");
     signal(SIGINT, cleanup);
     int clk = 0;
-    //Create shared memory for one integer variable 4 bytes
-    shmid = shmget(SHKEY, 4, IPC_CREAT | 0644);
+    int virtualTime = 0, opt;
+    // -v for virtual time, -e fd to notify the ticks on an eventfd too
+    while ((opt = getopt(argc, argv, "ve:")) != -1)
+    {
+        if (opt == 'v')
+            virtualTime = 1;
+        else if (opt == 'e')
+            tickFd = atoi(optarg);
+    }
+    //Create shared memory for the clock, it starts zeroed
+    shmid = shmget(SHKEY, sizeof(clk_shm_t), IPC_CREAT | IPC_EXCL | 0644);
+    if ((long)shmid == -1 && errno == EEXIST)
+    {
+        //left by an interrupted run
+        shmctl(shmget(SHKEY, 0, 0644), IPC_RMID, NULL);
+        shmid = shmget(SHKEY, sizeof(clk_shm_t), IPC_CREAT | IPC_EXCL | 0644);
+    }
     if ((long)shmid == -1)
     {
         perror("Error in creating shm!");
         exit(-1);
     }
-    int * shmaddr = (int *) shmat(shmid, (void *)0, 0);
+    shmaddr = (int *) shmat(shmid, (void *)0, 0);
     if ((long)shmaddr == -1)
     {
         perror("Error in attaching the shm in clock!");
         exit(-1);
     }
-    *shmaddr = clk; /* initialize shared memory */
+    clkShm = (clk_shm_t *) shmaddr;
+    clkShm->virtualTime = virtualTime;
+    Tick(clk); /* initialize shared memory */
     while (1)
     {
-        sleep(1);
-        (*shmaddr)++;
+        if (virtualTime)
+        {
+            // read the generation first so a report after the check wakes us
+            int gen = __atomic_load_n(&clkShm->doneGen, __ATOMIC_SEQ_CST);
+            int next = NextVirtualTick(clkShm);
+            if (next == -1)
+            {
+                clkSleep(gen);
+                continue;
+            }
+            Tick(next);
+        }
+        else
+        {
+            sleep(1);
+            Tick(++clk);
+        }
+    }
+}
+
+/**
+ * @brief Publish the tick, then add one to the eventfd so a poller finds the
+ * new tick once it's readable.
+ *
+ * @param tick the new tick
+ */
+void Tick(int tick)
+{
+    setClk(tick);
+
+    uint64_t one = 1;
+    if (tickFd != -1 && write(tickFd, &one, sizeof(one)) == -1)
+    {
+        perror("clock: couldn't notify the tick");
+        tickFd = -1;
+    }
+}
+
+/**
+ * @brief Get the tick the virtual clock should jump to.
+ *
+ * @param shm the clock shared memory
+ * @return int -1 if a participant is still working on the current tick,
+ * the earliest tick one of the participants asked for otherwise.
+ */
+int NextVirtualTick(clk_shm_t *shm)
+{
+    int clk = shm->clk, next = INT_MAX, anyActive = 0;
+
+    for (int part = 0; part < CLK_NPARTS; part++)
+    {
+        if (!__atomic_load_n(&shm->active[part], __ATOMIC_ACQUIRE))
+            continue;
+
+        anyActive = 1;
+        if (__atomic_load_n(&shm->doneTick[part], __ATOMIC_ACQUIRE) < clk)
+            return -1;
+        if (shm->nextTick[part] < next)
+            next = shm->nextTick[part];
+    }
+
+    // nobody joined yet, or everybody left
+    if (!anyActive)
+        return -1;
+
+    // never go backwards, and don't stall if nobody expects anything
+    if (next <= clk || next == INT_MAX)
+        next = clk + 1;
+
+    return next;
+}
+
+/**
+ * @brief Print how long every party took to arrive at the tick barrier after
+ * the tick was published, so it's clear who stalls the ticks.
+ *
+ * @param shm the clock shared memory
+ */
+void PrintBarrierStats(clk_shm_t *shm)
+{
+    printf("Tick barrier: party arrivals avg(us) max(us)\n");
+    for (int part = 0; part < CLK_NPARTS; part++)
+    {
+        if (shm->arrivals[part] == 0)
+            continue;
+
+        char name[16];
+        if (part == CLK_GEN)
+            strcpy(name, "generator");
+        else if (part == CLK_SCHED)
+            strcpy(name, "scheduler");
+        else
+            snprintf(name, sizeof(name), "worker %d", part - CLK_WORKER(0));
+
+        printf("Tick barrier: %s %d %.1f %.1f\n", name, shm->arrivals[part],
+               shm->arriveNs[part] / 1000.0 / shm->arrivals[part], shm->maxArriveNs[part] / 1000.0);
     }
 }
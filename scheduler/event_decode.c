@@ -0,0 +1,167 @@
+/**
+ * @file event_decode.c
+ * @brief Render an event log of the scheduler as the text of scheduler.log,
+ * or of memory.log with -m, see event_log.c. With -j it's rendered as a
+ * timeline in the trace event format of Chrome and Perfetto: a track per CPU
+ * with the slices the processes ran, the depth of every run queue as a
+ * counter, the memory blocks as async spans and the arrivals as instants.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "sched_engine.h"
+#include "event_log.h"
+
+#define TICK_US 1000 /**< a tick is shown as a millisecond */
+#define PID_CPUS 1
+#define PID_MEMORY 2
+
+void RenderTimeline(const char *fileName, FILE *out);
+
+int main(int argc, char *argv[])
+{
+        int memory = 0, timeline = 0, opt;
+
+        // event_decode.out [-m | -j] [events]
+        while ((opt = getopt(argc, argv, "mj")) != -1)
+        {
+                if (opt == 'm')
+                        memory = 1;
+                else if (opt == 'j')
+                        timeline = 1;
+                else
+                {
+                        fprintf(stderr, "usage: %s [-m | -j] [events], -m renders memory.log, -j a trace event timeline\n", argv[0]);
+                        exit(EXIT_FAILURE);
+                }
+        }
+
+        const char *fileName = optind < argc ? argv[optind] : "scheduler.events";
+        if (timeline)
+                RenderTimeline(fileName, stdout);
+        else if (memory)
+                RenderEventLog(fileName, NULL, stdout);
+        else
+                RenderEventLog(fileName, stdout, NULL);
+}
+
+/**
+ * @brief Start the next element of the traceEvents array
+ */
+static void NextElement(FILE *out, int *first)
+{
+        fprintf(out, *first ? "\n" : ",\n");
+        *first = 0;
+}
+
+/**
+ * @brief Render the event log as a JSON trace, open it in ui.perfetto.dev or
+ * chrome://tracing
+ */
+void RenderTimeline(const char *fileName, FILE *out)
+{
+        event_log_header_t header;
+        event_t chunk[4096];
+        size_t n;
+        int first = 1;
+        long inUse = 0;
+
+        // the slice of every CPU that's still running
+        struct
+        {
+                int id;
+                int start;
+        } slices[MAX_CPUS];
+
+        FILE *fp = ReadEventLog(fileName, &header);
+        if (header.ncpu < 1 || header.ncpu > MAX_CPUS)
+        {
+                fprintf(stderr, "event_decode: %s has %d CPUs\n", fileName, header.ncpu);
+                exit(EXIT_FAILURE);
+        }
+
+        fprintf(out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+        NextElement(out, &first);
+        fprintf(out, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"CPUs\"}}", PID_CPUS);
+        NextElement(out, &first);
+        fprintf(out, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"memory\"}}", PID_MEMORY);
+        for (int cpu = 0; cpu < header.ncpu; cpu++)
+        {
+                NextElement(out, &first);
+                fprintf(out, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"CPU %d\"}}",
+                        PID_CPUS, cpu, cpu);
+                slices[cpu].id = -1;
+        }
+
+        while ((n = fread(chunk, sizeof(event_t), sizeof(chunk) / sizeof(event_t), fp)) > 0)
+        {
+                for (size_t i = 0; i < n; i++)
+                {
+                        const event_t *e = &chunk[i];
+                        long ts = (long)e->time * TICK_US;
+
+                        if (e->cpu < 0 || e->cpu >= header.ncpu)
+                        {
+                                fprintf(stderr, "event_decode: %s: an event on CPU %d\n", fileName, e->cpu);
+                                exit(EXIT_FAILURE);
+                        }
+
+                        switch (e->type)
+                        {
+                        case EVENT_STARTED:
+                        case EVENT_RESUMED:
+                                slices[e->cpu].id = e->id;
+                                slices[e->cpu].start = e->time;
+                                break;
+                        case EVENT_STOPPED:
+                        case EVENT_FINISHED:
+                                if (slices[e->cpu].id != e->id)
+                                        break;
+                                NextElement(out, &first);
+                                fprintf(out, "{\"name\":\"P%d\",\"cat\":\"run\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%ld,\"dur\":%ld,"
+                                             "\"args\":{\"id\":%d,\"arrival\":%d,\"total\":%d,\"remain\":%d,\"wait\":%d",
+                                        e->id, PID_CPUS, e->cpu, (long)slices[e->cpu].start * TICK_US,
+                                        (long)(e->time - slices[e->cpu].start) * TICK_US, e->id, e->state.arrival,
+                                        e->state.total, e->state.remaining, e->state.wait);
+                                if (e->type == EVENT_FINISHED)
+                                        fprintf(out, ",\"TA\":%d,\"WTA\":%g", e->state.ta, e->state.wta);
+                                fprintf(out, "}}");
+                                slices[e->cpu].id = -1;
+                                break;
+                        case EVENT_ALLOCATED:
+                        case EVENT_FREED:
+                                inUse += (e->type == EVENT_ALLOCATED ? 1 : -1) * (long)(e->memory.end - e->memory.start + 1);
+                                NextElement(out, &first);
+                                fprintf(out, "{\"name\":\"P%d\",\"cat\":\"memory\",\"ph\":\"%s\",\"id\":%d,\"pid\":%d,\"ts\":%ld,"
+                                             "\"args\":{\"bytes\":%d,\"start\":%d,\"end\":%d}}",
+                                        e->id, e->type == EVENT_ALLOCATED ? "b" : "e", e->id, PID_MEMORY, ts,
+                                        e->memory.bytes, e->memory.start, e->memory.end);
+                                NextElement(out, &first);
+                                fprintf(out, "{\"name\":\"memory in use\",\"ph\":\"C\",\"pid\":%d,\"ts\":%ld,\"args\":{\"bytes\":%ld}}",
+                                        PID_MEMORY, ts, inUse);
+                                break;
+                        case EVENT_ARRIVED:
+                        case EVENT_DROPPED:
+                                NextElement(out, &first);
+                                fprintf(out, "{\"name\":\"%s P%d\",\"cat\":\"arrival\",\"ph\":\"i\",\"s\":\"p\",\"pid\":%d,\"ts\":%ld,"
+                                             "\"args\":{\"id\":%d,\"total\":%d,\"priority\":%d,\"deadline\":%d,\"bytes\":%d",
+                                        e->type == EVENT_ARRIVED ? "arrival" : "dropped", e->id, PID_CPUS, ts, e->id,
+                                        e->process.total, e->process.priority, e->process.deadline, e->process.bytes);
+                                if (e->type == EVENT_ARRIVED)
+                                        fprintf(out, ",\"cpu\":%d", e->cpu);
+                                fprintf(out, "}}");
+                                break;
+                        case EVENT_READY:
+                                NextElement(out, &first);
+                                fprintf(out, "{\"name\":\"ready CPU %d\",\"ph\":\"C\",\"pid\":%d,\"ts\":%ld,\"args\":{\"ready\":%d}}",
+                                        e->cpu, PID_CPUS, ts, e->queue.ready);
+                                break;
+                        }
+                }
+        }
+        fprintf(out, "\n]}\n");
+        fclose(fp);
+}
@@ -0,0 +1,309 @@
+/**
+ * @file event_log.c
+ * @brief The scheduling events are logged as fixed size binary records into
+ * a ring in memory, a writer thread drains it to scheduler.events. The text
+ * of scheduler.log and memory.log is rendered from that file at the end, or
+ * offline with event_decode.out, so no event is formatted on the tick path.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <sched.h>
+#include <signal.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <limits.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include "event_log.h"
+
+#define EVENT_WAKE_MARK (EVENT_RING_SIZE / 4) /**< the scheduler wakes the writer once this many events wait */
+#define EVENT_FLUSH_MS 100                    /**< a sleeping writer still writes what waits this often */
+#define EVENT_FILE_BUFFER (1 << 20)
+
+static event_t events[EVENT_RING_SIZE];
+static unsigned eventHead = 0; /**< logged up to here, written by the scheduler */
+static unsigned eventTail = 0; /**< written to the file up to here, written by the writer */
+static int stopWriter = 0;
+static int writerAsleep = 0; /**< the writer waits on eventHead */
+
+static FILE *eventFile = NULL;
+static pthread_t writer;
+
+/**
+ * @brief Write the logged events to the file as they come, until the log is
+ * closed and the ring is empty
+ */
+static void *WriteEvents(void *arg)
+{
+        struct timespec flush = {EVENT_FLUSH_MS / 1000, (EVENT_FLUSH_MS % 1000) * 1000000L};
+
+        while (1)
+        {
+                // the stop is read first, nothing is logged after it
+                int stop = __atomic_load_n(&stopWriter, __ATOMIC_ACQUIRE);
+                unsigned head = __atomic_load_n(&eventHead, __ATOMIC_ACQUIRE);
+                if (head == eventTail)
+                {
+                        if (stop)
+                                break;
+
+                        // sleep until the scheduler wakes it, the head is
+                        // read again after the flag so no wake is missed
+                        __atomic_store_n(&writerAsleep, 1, __ATOMIC_SEQ_CST);
+                        if (__atomic_load_n(&eventHead, __ATOMIC_SEQ_CST) == head && !__atomic_load_n(&stopWriter, __ATOMIC_SEQ_CST))
+                                syscall(SYS_futex, &eventHead, FUTEX_WAIT_PRIVATE, head, &flush, NULL, 0);
+                        __atomic_store_n(&writerAsleep, 0, __ATOMIC_RELAXED);
+                        continue;
+                }
+
+                // up to the end of the ring, the rest at the next round
+                unsigned from = eventTail & (EVENT_RING_SIZE - 1), n = head - eventTail;
+                if (from + n > EVENT_RING_SIZE)
+                        n = EVENT_RING_SIZE - from;
+                if (fwrite(&events[from], sizeof(event_t), n, eventFile) != n)
+                {
+                        perror("event log: couldn't write the events");
+                        exit(EXIT_FAILURE);
+                }
+                __atomic_store_n(&eventTail, eventTail + n, __ATOMIC_RELEASE);
+        }
+        return NULL;
+}
+
+/**
+ * @brief Wake the writer if it sleeps
+ */
+static void WakeWriter()
+{
+        if (__atomic_exchange_n(&writerAsleep, 0, __ATOMIC_SEQ_CST))
+                syscall(SYS_futex, &eventHead, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+}
+
+/**
+ * @brief Create the event log and start its writer
+ *
+ * @param fileName the binary log, scheduler.events
+ * @param ncpu the number of CPUs
+ */
+void OpenEventLog(const char *fileName, int ncpu)
+{
+        event_log_header_t header = {.version = EVENT_VERSION, .ncpu = ncpu};
+        memcpy(header.magic, EVENT_MAGIC, sizeof(header.magic));
+
+        eventFile = fopen(fileName, "wb");
+        if (eventFile == NULL)
+        {
+                perror("Schedular: Can not create the event log\n");
+                exit(EXIT_FAILURE);
+        }
+        setvbuf(eventFile, NULL, _IOFBF, EVENT_FILE_BUFFER);
+        fwrite(&header, sizeof(header), 1, eventFile);
+
+        eventHead = eventTail = 0;
+        stopWriter = 0;
+        writerAsleep = 0;
+
+        // the writer starts with every signal blocked, the signals of the
+        // driver are its main thread's to take
+        sigset_t all, old;
+        sigfillset(&all);
+        pthread_sigmask(SIG_SETMASK, &all, &old);
+        int err = pthread_create(&writer, NULL, WriteEvents, NULL);
+        pthread_sigmask(SIG_SETMASK, &old, NULL);
+        if (err != 0)
+        {
+                perror("Schedular: Can not start the event log writer\n");
+                exit(EXIT_FAILURE);
+        }
+}
+
+/**
+ * @brief The next free record of the ring, it's only seen by the writer once
+ * it's published
+ */
+static event_t *NextRecord(int type, int time, int id, int cpu)
+{
+        while (eventHead - __atomic_load_n(&eventTail, __ATOMIC_ACQUIRE) == EVENT_RING_SIZE)
+        {
+                WakeWriter();
+                sched_yield();
+        }
+
+        event_t *event = &events[eventHead & (EVENT_RING_SIZE - 1)];
+        event->type = type;
+        event->time = time;
+        event->id = id;
+        event->cpu = cpu;
+        return event;
+}
+
+/**
+ * @brief Hand the record of NextRecord() to the writer. It's only woken once
+ * EVENT_WAKE_MARK events wait, fewer are written at the next flush.
+ */
+static void Publish()
+{
+        __atomic_store_n(&eventHead, eventHead + 1, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&writerAsleep, __ATOMIC_SEQ_CST) &&
+            eventHead - __atomic_load_n(&eventTail, __ATOMIC_ACQUIRE) >= EVENT_WAKE_MARK)
+                WakeWriter();
+}
+
+/**
+ * @brief Log a scheduler.log event, the PCB was started, stopped, resumed or finished
+ *
+ * @param ta the turnaround of a finished PCB
+ * @param wta its weighted turnaround
+ */
+void LogStateEvent(int type, int time, const PCB *pcb, int ta, float wta)
+{
+        event_t *event = NextRecord(type, time, pcb->id, pcb->cpu);
+        event->state.arrival = pcb->arrivalTime;
+        event->state.total = pcb->runTime;
+        event->state.remaining = pcb->remainingTime;
+        event->state.wait = pcb->waitingTime;
+        event->state.ta = ta;
+        event->state.wta = wta;
+        Publish();
+}
+
+/**
+ * @brief Log a memory.log event, the memory block of the PCB was allocated or freed
+ */
+void LogMemoryEvent(int type, int time, const PCB *pcb)
+{
+        event_t *event = NextRecord(type, time, pcb->id, pcb->cpu);
+        event->memory.bytes = pcb->memoryNode->data;
+        event->memory.start = pcb->memoryNode->start;
+        event->memory.end = pcb->memoryNode->end;
+        Publish();
+}
+
+/**
+ * @brief Log the arrival of a PCB, or that it was dropped
+ *
+ * @param bytes the memory it asked for
+ */
+void LogArrivalEvent(int type, int time, const PCB *pcb, int bytes)
+{
+        event_t *event = NextRecord(type, time, pcb->id, pcb->cpu);
+        event->process.total = pcb->runTime;
+        event->process.priority = pcb->priority;
+        event->process.deadline = pcb->deadline;
+        event->process.bytes = bytes;
+        Publish();
+}
+
+/**
+ * @brief Log the number of PCBs waiting in the run queue of the CPU
+ */
+void LogReadyEvent(int time, int cpu, int ready)
+{
+        event_t *event = NextRecord(EVENT_READY, time, 0, cpu);
+        event->queue.ready = ready;
+        Publish();
+}
+
+/**
+ * @brief Wait for the writer to drain the ring and close the log
+ */
+void CloseEventLog()
+{
+        __atomic_store_n(&stopWriter, 1, __ATOMIC_SEQ_CST);
+        WakeWriter();
+        pthread_join(writer, NULL);
+        fclose(eventFile);
+        eventFile = NULL;
+}
+
+/**
+ * @brief Open an event log and check its header, the records follow
+ *
+ * @param header gets the header of the log
+ * @return FILE* the log, at its first record
+ */
+FILE *ReadEventLog(const char *fileName, event_log_header_t *header)
+{
+        FILE *fp = fopen(fileName, "rb");
+        if (fp == NULL)
+        {
+                perror("event log: Can not open the event log\n");
+                exit(EXIT_FAILURE);
+        }
+        if (fread(header, sizeof(event_log_header_t), 1, fp) != 1 ||
+            memcmp(header->magic, EVENT_MAGIC, sizeof(header->magic)) != 0 || header->version != EVENT_VERSION)
+        {
+                fprintf(stderr, "event log: %s isn't an event log of version %d\n", fileName, EVENT_VERSION);
+                exit(EXIT_FAILURE);
+        }
+        return fp;
+}
+
+/**
+ * @brief Render an event log as the text of scheduler.log and memory.log
+ *
+ * @param fileName the binary log
+ * @param log gets the scheduler.log lines, NULL to skip them
+ * @param memoryLog gets the memory.log lines, NULL to skip them
+ */
+void RenderEventLog(const char *fileName, FILE *log, FILE *memoryLog)
+{
+        static const char *states[] = {"started", "stopped", "resumed"};
+        event_log_header_t header;
+        event_t chunk[4096];
+        size_t n;
+
+        FILE *fp = ReadEventLog(fileName, &header);
+
+        if (memoryLog != NULL)
+                fprintf(memoryLog, "#At time x allocated y bytes from process z from i to j \n");
+        if (log != NULL)
+                fprintf(log, "#At time x process y state arr w total z remain y wait k\n");
+
+        while ((n = fread(chunk, sizeof(event_t), sizeof(chunk) / sizeof(event_t), fp)) > 0)
+        {
+                for (size_t i = 0; i < n; i++)
+                {
+                        const event_t *e = &chunk[i];
+
+                        // only the timeline shows them
+                        if (e->type == EVENT_ARRIVED || e->type == EVENT_DROPPED || e->type == EVENT_READY)
+                                continue;
+
+                        if (e->type == EVENT_ALLOCATED || e->type == EVENT_FREED)
+                        {
+                                if (memoryLog == NULL)
+                                        continue;
+                                if (e->type == EVENT_ALLOCATED)
+                                        fprintf(memoryLog, "At time %d allocated %d bytes for process %d from %d to %d \n",
+                                                e->time, e->memory.bytes, e->id, e->memory.start, e->memory.end);
+                                else
+                                        fprintf(memoryLog, "At time %d freed %d bytes from process %d from %d to %d \n",
+                                                e->time, e->memory.bytes, e->id, e->memory.start, e->memory.end);
+                                continue;
+                        }
+
+                        if (log == NULL)
+                                continue;
+                        if (e->type == EVENT_FINISHED)
+                                fprintf(log, "At time %d process %d finished arr %d total %d remain %d wait %d TA %d WTA %g",
+                                        e->time, e->id, e->state.arrival, e->state.total, e->state.remaining, e->state.wait,
+                                        e->state.ta, round(e->state.wta * 100.0) / 100.0);
+                        else
+                                fprintf(log, "At time %d process %d %s arr %d total %d remain %d wait %d",
+                                        e->time, e->id, states[e->type], e->state.arrival, e->state.total,
+                                        e->state.remaining, e->state.wait);
+                        // the CPU only if there are several
+                        if (header.ncpu > 1)
+                                fprintf(log, " cpu %d", e->cpu);
+                        fprintf(log, "\n");
+                }
+        }
+        fclose(fp);
+}
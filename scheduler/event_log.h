@@ -0,0 +1,98 @@
+/**
+ * @file event_log.h
+ * @brief The scheduling events are logged as fixed size binary records into
+ * a ring in memory, a writer thread drains it to scheduler.events. The text
+ * of scheduler.log and memory.log is rendered from that file at the end, or
+ * offline with event_decode.out, so no event is formatted on the tick path.
+ * The arrivals and the depths of the run queues are logged too, they only go
+ * to the timeline event_decode.out -j renders.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#ifndef _EVENT_LOG_H
+#define _EVENT_LOG_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include "pcb.h"
+
+#define EVENT_MAGIC "SCHDEVT\n" /**< the first 8 bytes of an event log */
+#define EVENT_VERSION 2
+#define EVENT_RING_SIZE 65536   /**< a power of 2, a full ring makes the scheduler wait for the writer */
+
+enum EventType
+{
+        EVENT_STARTED,
+        EVENT_STOPPED,
+        EVENT_RESUMED,
+        EVENT_FINISHED,
+        EVENT_ALLOCATED,
+        EVENT_FREED,
+        EVENT_ARRIVED, /**< on the CPU of its run queue */
+        EVENT_DROPPED, /**< its memory couldn't be allocated */
+        EVENT_READY    /**< the depth of the run queue of the CPU changed */
+};
+
+/**
+ * @brief The header of an event log, the records follow it
+ */
+typedef struct
+{
+        char magic[8];  /**< EVENT_MAGIC */
+        uint32_t version;
+        int32_t ncpu;   /**< the lines only name the CPU if there are several */
+} event_log_header_t;
+
+/**
+ * @brief An event of a process. The state of its PCB for the scheduler.log
+ * events, its memory block for the memory.log ones, the process for an
+ * arrival and the depth of the run queue for EVENT_READY.
+ */
+typedef struct
+{
+        int32_t type; /**< an EventType */
+        int32_t time;
+        int32_t id;
+        int32_t cpu;
+        union
+        {
+                struct
+                {
+                        int32_t arrival;
+                        int32_t total;
+                        int32_t remaining;
+                        int32_t wait;
+                        int32_t ta;  /**< finished only */
+                        float wta;   /**< finished only */
+                } state;
+                struct
+                {
+                        int32_t bytes;
+                        int32_t start;
+                        int32_t end;
+                } memory;
+                struct
+                {
+                        int32_t total;
+                        int32_t priority;
+                        int32_t deadline; /**< absolute, 0 for none */
+                        int32_t bytes;
+                } process;
+                struct
+                {
+                        int32_t ready;
+                } queue;
+        };
+} event_t;
+
+void OpenEventLog(const char *fileName, int ncpu);
+void LogStateEvent(int type, int time, const PCB *pcb, int ta, float wta);
+void LogMemoryEvent(int type, int time, const PCB *pcb);
+void LogArrivalEvent(int type, int time, const PCB *pcb, int bytes);
+void LogReadyEvent(int time, int cpu, int ready);
+void CloseEventLog();
+FILE *ReadEventLog(const char *fileName, event_log_header_t *header);
+void RenderEventLog(const char *fileName, FILE *log, FILE *memoryLog);
+
+#endif /* _EVENT_LOG_H */
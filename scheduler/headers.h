@@ -11,6 +11,10 @@
 #include <unistd.h>
 #include <signal.h>
 #include <errno.h>
+#include <limits.h>
+#include <time.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
 
 
 #define DEBUG
@@ -20,73 +24,126 @@ typedef short bool;
 #define false 0
 
 #define SHKEY 300
-#define MSGQKEY 65
 
-// semaphore keys
-#define SEM_SCHED_GEN_KEY 70
-#define SEM_SCHED_PROC_KEY 80
+// Tick barrier parties, see tickArrive(). Only the generator and the
+// scheduler hold the virtual clock, see clkJoin()
+#define CLK_GEN 0
+#define CLK_SCHED 1
+#define CLK_WORKER(cpu) (2 + (cpu))
+#define CLK_MAX_WORKERS 64
+#define CLK_NPARTS (2 + CLK_MAX_WORKERS)
 
-// Process remaining time shared memory key
-#define PRSHKEY 301
+// spins on the barrier before sleeping on the futex
+#define CLK_SPIN 4096
 
-#define SIGMSGQ SIGUSR1
-#define SIGPF SIGUSR2
-#define SIGSLP SIGUSR1
+// a worker's process finished, a real-time signal so the finishes of a tick
+// are queued one by one and don't merge into one
+#define SIGPF (SIGRTMIN + 1)
+
+/**
+ * @brief Layout of the clock shared memory. clk has to stay the first member
+ * because shmaddr points to it.
+ */
+typedef struct
+{
+    int clk;                    /**< the current tick */
+    int tickGen;                /**< bumped after every tick, waitClk() sleeps on it */
+    int tickWaiters;            /**< processes sleeping in waitClk() */
+    int doneGen;                /**< bumped whenever a party arrives, tickWait() and the virtual clock sleep on it */
+    int doneWaiters;            /**< processes sleeping on doneGen */
+    int virtualTime;            /**< 1 if the clock jumps to the next event instead of sleeping */
+    int arrivalRoom;            /**< the arrivals the scheduler takes at the next tick, the generator holds the others back */
+    long long tickStart;        /**< CLOCK_MONOTONIC ns the current tick was published at */
+    int active[CLK_NPARTS];     /**< 1 if the participant has to finish a tick before the clock moves */
+    int doneTick[CLK_NPARTS];   /**< the last tick the party arrived at the barrier */
+    int nextTick[CLK_NPARTS];   /**< the next tick the participant has something to do */
+    int arrivals[CLK_NPARTS];   /**< number of barrier arrivals of the party */
+    long long arriveNs[CLK_NPARTS];    /**< total ns from the start of a tick to the party's arrival */
+    long long maxArriveNs[CLK_NPARTS]; /**< the slowest arrival of the party */
+} clk_shm_t;
 
 ///==============================
 //don't mess with this variable//
 int * shmaddr;                 //
 //===============================
+clk_shm_t *clkShm;
 
-/* arg for semctl system calls. */
-union Semun
+int futexWait(int *addr, int val)
 {
-    int val;               /* value for SETVAL */
-    struct semid_ds *buf;  /* buffer for IPC_STAT & IPC_SET */
-    ushort *array;         /* array for GETALL & SETALL */
-    struct seminfo *__buf; /* buffer for IPC_INFO */
-    void *__pad;
-};
+    return syscall(SYS_futex, addr, FUTEX_WAIT, val, NULL, NULL, 0);
+}
 
-void down(int sem)
+void futexWake(int *addr)
 {
-    //union Semun semun;
-    //int val = semctl(sem, 0, GETVAL, semun);
-    //printf("sem value is %d\n", val);
+    syscall(SYS_futex, addr, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
 
-    struct sembuf p_op;
+long long monoNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
 
-    p_op.sem_num = 0;
-    p_op.sem_op = -1;
-    p_op.sem_flg = !IPC_NOWAIT;
+int getClk()
+{
+    return *shmaddr;
+}
 
-    if (semop(sem, &p_op, 1) == -1)
+/*
+ * Sleep until the clock is no longer at tick and return the current tick.
+ * It returns tick itself if a signal interrupted the sleep, so the caller can
+ * look at what the handler changed.
+*/
+int waitClk(int tick)
+{
+    while (1)
     {
-        if (errno != EINTR) {
-            perror("Error in down()");
-            exit(-1);
-        }
+        int gen = __atomic_load_n(&clkShm->tickGen, __ATOMIC_SEQ_CST);
+        int now = __atomic_load_n(shmaddr, __ATOMIC_SEQ_CST);
+        if (now != tick)
+            return now;
+
+        __atomic_add_fetch(&clkShm->tickWaiters, 1, __ATOMIC_SEQ_CST);
+        int rt = futexWait(&clkShm->tickGen, gen);
+        __atomic_sub_fetch(&clkShm->tickWaiters, 1, __ATOMIC_SEQ_CST);
+
+        if (rt == -1 && errno == EINTR)
+            return getClk();
     }
 }
 
-void up(int sem)
+/*
+ * Publish a new tick and wake everybody sleeping in waitClk(). Only the clock calls it.
+*/
+void setClk(int tick)
 {
-    struct sembuf v_op;
-
-    v_op.sem_num = 0;
-    v_op.sem_op = 1;
-    v_op.sem_flg = !IPC_NOWAIT;
+    clkShm->tickStart = monoNs();
+    __atomic_store_n(shmaddr, tick, __ATOMIC_SEQ_CST);
+    __atomic_add_fetch(&clkShm->tickGen, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&clkShm->tickWaiters, __ATOMIC_SEQ_CST))
+        futexWake(&clkShm->tickGen);
+}
 
-    if (semop(sem, &v_op, 1) == -1)
-    {
-        perror("Error in up()");
-        exit(-1);
-    }
+/*
+ * Tell the barrier waiters and the virtual clock that the participant table
+ * or an arrival changed.
+*/
+void clkNotify()
+{
+    __atomic_add_fetch(&clkShm->doneGen, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&clkShm->doneWaiters, __ATOMIC_SEQ_CST))
+        futexWake(&clkShm->doneGen);
 }
 
-int getClk()
+/*
+ * Sleep until doneGen moves from gen.
+*/
+void clkSleep(int gen)
 {
-    return *shmaddr;
+    __atomic_add_fetch(&clkShm->doneWaiters, 1, __ATOMIC_SEQ_CST);
+    futexWait(&clkShm->doneGen, gen);
+    __atomic_sub_fetch(&clkShm->doneWaiters, 1, __ATOMIC_SEQ_CST);
 }
 
 
@@ -96,17 +153,106 @@ int getClk()
 */
 void initClk()
 {
-    int shmid = shmget(SHKEY, 4, 0444);
+    struct timespec backoff = {0, 100000};
+    int shmid = shmget(SHKEY, sizeof(clk_shm_t), 0444);
     while ((int)shmid == -1)
     {
-        //Make sure that the clock exists
-        //printf("Wait! The clock not initialized yet!\n");
-        //sleep(1);
-        shmid = shmget(SHKEY, 4, 0444);
+        //Make sure that the clock exists, it's created right after the fork
+        //so back off instead of spinning on shmget
+        nanosleep(&backoff, NULL);
+        if (backoff.tv_nsec < 10000000)
+            backoff.tv_nsec *= 2;
+        shmid = shmget(SHKEY, sizeof(clk_shm_t), 0444);
     }
     shmaddr = (int *) shmat(shmid, (void *)0, 0);
+    clkShm = (clk_shm_t *) shmaddr;
+}
+
+/*
+ * Tick barrier: every tick the clock publishes, the generator, the running
+ * workers and the scheduler arrive in that order:
+ *  - the generator arrives once it has sent the arrivals of the tick,
+ *  - a worker arrives once it has written its remaining time for the tick,
+ *  - the scheduler waits for the generator and its running workers, schedules
+ *    and arrives with clkDone(), then the virtual clock may move.
+ * A party that left arrives at every tick, so nobody waits for it.
+ */
+
+/*
+ * The party part is done with the current tick.
+*/
+void tickArrive(int part)
+{
+    int clk = clkShm->clk;
+    long long ns = monoNs() - clkShm->tickStart;
+
+    clkShm->arrivals[part]++;
+    clkShm->arriveNs[part] += ns;
+    if (ns > clkShm->maxArriveNs[part])
+        clkShm->maxArriveNs[part] = ns;
+
+    __atomic_store_n(&clkShm->doneTick[part], clk, __ATOMIC_RELEASE);
+    clkNotify();
+}
+
+/*
+ * Wait until the party part arrived at tick. Spins a little first, parties
+ * usually arrive within a few microseconds, then sleeps on the futex.
+*/
+void tickWait(int part, int tick)
+{
+    for (int spin = 0; spin < CLK_SPIN; spin++)
+    {
+        if (__atomic_load_n(&clkShm->doneTick[part], __ATOMIC_ACQUIRE) >= tick)
+            return;
+    }
+
+    while (1)
+    {
+        int gen = __atomic_load_n(&clkShm->doneGen, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&clkShm->doneTick[part], __ATOMIC_SEQ_CST) >= tick)
+            return;
+        clkSleep(gen);
+    }
+}
+
+/*
+ * Virtual time: the clock doesn't sleep a second per tick. It waits until every
+ * active participant has finished the current tick, then jumps straight to the
+ * earliest tick one of them has something to do at.
+ * In real time mode the calls below are harmless bookkeeping.
+ */
+
+/*
+ * Make the clock wait for the participant part from the current tick on.
+*/
+void clkJoin(int part)
+{
+    clkShm->doneTick[part] = clkShm->clk - 1;
+    clkShm->nextTick[part] = clkShm->clk;
+    __atomic_store_n(&clkShm->active[part], 1, __ATOMIC_RELEASE);
+    clkNotify();
+}
+
+/*
+ * The participant part finished the current tick and has nothing to do before nextTick.
+ * Use INT_MAX if it only reacts to the others.
+*/
+void clkDone(int part, int nextTick)
+{
+    clkShm->nextTick[part] = nextTick;
+    tickArrive(part);
+}
+
+/*
+ * The participant part won't take part in any further tick.
+*/
+void clkLeave(int part)
+{
+    __atomic_store_n(&clkShm->active[part], 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&clkShm->doneTick[part], INT_MAX, __ATOMIC_RELEASE);
+    clkNotify();
 }
-  
 
 /*
  * All process call this function at the end to release the communication
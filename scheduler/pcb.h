@@ -9,6 +9,7 @@
 #ifndef _PCB_H
 #define _PCB_H
 #include "buddy.h"
+#include "rb_tree.h"
 typedef enum
 {
     READY,
@@ -27,8 +28,16 @@ typedef struct
     int remainingTime; // Remaining time to finish
     STATE state;
     int waitingTime; // Total time from creation to first run
+    int responseTime; // Ticks from its arrival to its first run
     int waitStart;   // Start time for waiting
     node *memoryNode;
+    int cpu;         // The CPU it runs or last ran on
+    int worker;      // The worker pool slot of the process.out that runs it
+    int deadline;    // Absolute deadline, 0 if it has none
+    int level;       // MLFQ level, 0 is the top
+    int quantumUsed; // Ticks used from the MLFQ quantum of its level
+    long vruntime;   // CFS virtual runtime, the run time scaled by the priority's weight
+    rb_node runNode; // CFS run queue node, keyed on vruntime
 
 } PCB;
 
@@ -0,0 +1,248 @@
+/**
+ * @file pcb_pool.c
+ * @brief The PCBs are carved out of slabs and recycled through a free list,
+ * so an arrival doesn't go to malloc. Every PCB in use can be looked up by
+ * its process id and, once it runs, by the pid of its process.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pcb_pool.h"
+
+#define PCB_MAP_MIN_CAPACITY 64
+
+PCB **slabs = NULL; /**< every slab is freed at the end */
+int nslabs = 0, slabsCapacity = 0;
+
+PCB **freePCBs = NULL; /**< a stack of the PCBs that aren't in use */
+int nfree = 0, freeCapacity = 0;
+
+struct PCBMap pcbsById, pcbsByPid;
+
+static void *PoolAlloc(void *old, size_t bytes)
+{
+        void *mem = realloc(old, bytes);
+        if (mem == NULL)
+        {
+                perror("pcb pool: out of memory");
+                exit(EXIT_FAILURE);
+        }
+        return mem;
+}
+
+/**
+ * @brief Fibonacci hashing, consecutive ids end up far apart
+ */
+static unsigned MapSlot(struct PCBMap *map, int key)
+{
+        return ((unsigned)key * 2654435761u) & (map->capacity - 1);
+}
+
+static void MapPut(struct PCBMap *map, int key, PCB *pcb);
+
+/**
+ * @brief Double the table, it's kept at most half full so the probes stay short
+ */
+static void MapGrow(struct PCBMap *map)
+{
+        int *keys = map->keys;
+        PCB **pcbs = map->pcbs;
+        int capacity = map->capacity;
+
+        map->capacity = capacity ? capacity * 2 : PCB_MAP_MIN_CAPACITY;
+        map->keys = PoolAlloc(NULL, sizeof(int) * map->capacity);
+        map->pcbs = PoolAlloc(NULL, sizeof(PCB *) * map->capacity);
+        memset(map->pcbs, 0, sizeof(PCB *) * map->capacity);
+        map->size = 0;
+
+        for (int i = 0; i < capacity; i++)
+        {
+                if (pcbs[i] != NULL)
+                        MapPut(map, keys[i], pcbs[i]);
+        }
+        free(keys);
+        free(pcbs);
+}
+
+/**
+ * @brief Map key to pcb, a PCB already there with the same key is replaced
+ */
+static void MapPut(struct PCBMap *map, int key, PCB *pcb)
+{
+        if ((map->size + 1) * 2 > map->capacity)
+                MapGrow(map);
+
+        unsigned i = MapSlot(map, key);
+        while (map->pcbs[i] != NULL)
+        {
+                if (map->keys[i] == key)
+                {
+                        map->pcbs[i] = pcb;
+                        return;
+                }
+                i = (i + 1) & (map->capacity - 1);
+        }
+
+        map->keys[i] = key;
+        map->pcbs[i] = pcb;
+        map->size++;
+}
+
+/**
+ * @return int the slot of key, -1 if it's not in the table
+ */
+static int MapFind(struct PCBMap *map, int key)
+{
+        if (map->capacity == 0)
+                return -1;
+
+        unsigned i = MapSlot(map, key);
+        while (map->pcbs[i] != NULL)
+        {
+                if (map->keys[i] == key)
+                        return i;
+                i = (i + 1) & (map->capacity - 1);
+        }
+        return -1;
+}
+
+/**
+ * @brief Remove key if it maps to pcb. The entries after it in its probe run
+ * are shifted back into the hole, so no tombstones are needed.
+ */
+static void MapRemove(struct PCBMap *map, int key, PCB *pcb)
+{
+        int found = MapFind(map, key);
+        if (found == -1 || map->pcbs[found] != pcb)
+                return;
+
+        unsigned mask = map->capacity - 1, hole = found, j = found;
+        while (1)
+        {
+                j = (j + 1) & mask;
+                if (map->pcbs[j] == NULL)
+                        break;
+
+                // an entry may only move back if the hole is between its home slot and it
+                unsigned home = MapSlot(map, map->keys[j]);
+                if (((j - home) & mask) >= ((j - hole) & mask))
+                {
+                        map->keys[hole] = map->keys[j];
+                        map->pcbs[hole] = map->pcbs[j];
+                        hole = j;
+                }
+        }
+
+        map->pcbs[hole] = NULL;
+        map->size--;
+}
+
+/**
+ * @brief Allocate a slab and put its PCBs on the free list, the first one on top
+ */
+static void NewSlab()
+{
+        if (nslabs == slabsCapacity)
+        {
+                slabsCapacity = slabsCapacity ? slabsCapacity * 2 : 16;
+                slabs = PoolAlloc(slabs, sizeof(PCB *) * slabsCapacity);
+        }
+        PCB *slab = PoolAlloc(NULL, sizeof(PCB) * PCB_SLAB_SIZE);
+        slabs[nslabs++] = slab;
+
+        if (nfree + PCB_SLAB_SIZE > freeCapacity)
+        {
+                freeCapacity = nfree + PCB_SLAB_SIZE;
+                freePCBs = PoolAlloc(freePCBs, sizeof(PCB *) * freeCapacity);
+        }
+        for (int i = PCB_SLAB_SIZE - 1; i >= 0; i--)
+                freePCBs[nfree++] = &slab[i];
+}
+
+/**
+ * @brief Get a zeroed PCB for the process id, the policies' own fields start
+ * zeroed too
+ *
+ * @param id the process id it's looked up by
+ */
+PCB *AllocPCB(int id)
+{
+        if (nfree == 0)
+                NewSlab();
+
+        PCB *pcb = freePCBs[--nfree];
+        memset(pcb, 0, sizeof(PCB));
+        pcb->id = id;
+        MapPut(&pcbsById, id, pcb);
+        return pcb;
+}
+
+/**
+ * @brief Give the PCB back to the pool, it can't be looked up anymore
+ */
+void FreePCB(PCB *pcb)
+{
+        MapRemove(&pcbsById, pcb->id, pcb);
+        if (pcb->pid > 0)
+                MapRemove(&pcbsByPid, pcb->pid, pcb);
+
+        if (nfree == freeCapacity)
+        {
+                freeCapacity *= 2;
+                freePCBs = PoolAlloc(freePCBs, sizeof(PCB *) * freeCapacity);
+        }
+        freePCBs[nfree++] = pcb;
+}
+
+/**
+ * @brief Set the pid of the PCB's process, a pid of 0 or less isn't looked up
+ */
+void SetPCBPid(PCB *pcb, int pid)
+{
+        if (pcb->pid > 0)
+                MapRemove(&pcbsByPid, pcb->pid, pcb);
+        pcb->pid = pid;
+        if (pid > 0)
+                MapPut(&pcbsByPid, pid, pcb);
+}
+
+/**
+ * @return PCB* the PCB in use with the process id, NULL if there's none
+ */
+PCB *PCBById(int id)
+{
+        int i = MapFind(&pcbsById, id);
+        return i == -1 ? NULL : pcbsById.pcbs[i];
+}
+
+/**
+ * @return PCB* the PCB whose process has the pid, NULL if there's none
+ */
+PCB *PCBByPid(int pid)
+{
+        int i = MapFind(&pcbsByPid, pid);
+        return i == -1 ? NULL : pcbsByPid.pcbs[i];
+}
+
+/**
+ * @brief Free the slabs and the tables, the PCBs still in use go with them
+ */
+void DestroyPCBPool()
+{
+        for (int i = 0; i < nslabs; i++)
+                free(slabs[i]);
+        free(slabs);
+        free(freePCBs);
+        free(pcbsById.keys);
+        free(pcbsById.pcbs);
+        free(pcbsByPid.keys);
+        free(pcbsByPid.pcbs);
+
+        slabs = freePCBs = NULL;
+        nslabs = slabsCapacity = nfree = freeCapacity = 0;
+        memset(&pcbsById, 0, sizeof(pcbsById));
+        memset(&pcbsByPid, 0, sizeof(pcbsByPid));
+}
@@ -0,0 +1,36 @@
+/**
+ * @file pcb_pool.h
+ * @brief The PCBs are carved out of slabs and recycled through a free list,
+ * so an arrival doesn't go to malloc. Every PCB in use can be looked up by
+ * its process id and, once it runs, by the pid of its process.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#ifndef _PCB_POOL_H
+#define _PCB_POOL_H
+
+#include "pcb.h"
+
+#define PCB_SLAB_SIZE 256 /**< the PCBs allocated at once when the free list is empty */
+
+/**
+ * @brief An open addressing hash table from an int key to a PCB, with linear
+ * probing. The ids of a trace don't have to be dense or start at 1.
+ */
+struct PCBMap
+{
+        int *keys;
+        PCB **pcbs;     /**< NULL for an empty slot */
+        int capacity;   /**< a power of 2 */
+        int size;
+};
+
+PCB *AllocPCB(int id);
+void FreePCB(PCB *pcb);
+void SetPCBPid(PCB *pcb, int pid);
+PCB *PCBById(int id);
+PCB *PCBByPid(int pid);
+void DestroyPCBPool();
+
+#endif /* _PCB_POOL_H */
@@ -0,0 +1,158 @@
+/**
+ * @file policy.c
+ * @brief The registry the scheduling policies are looked up by name in.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "policy.h"
+
+extern const policy_t srtnPolicy, rrPolicy, hpfPolicy, mlfqPolicy, cfsPolicy, edfPolicy;
+
+const policy_t *policies[POLICY_MAX];
+int numPolicies = 0;
+
+/**
+ * @brief Register the policies that come with the scheduler. Their order is
+ * the number the user picks them by.
+ */
+void RegisterBuiltinPolicies()
+{
+        if (numPolicies != 0)
+                return;
+
+        RegisterPolicy(&srtnPolicy);
+        RegisterPolicy(&rrPolicy);
+        RegisterPolicy(&hpfPolicy);
+        RegisterPolicy(&mlfqPolicy);
+        RegisterPolicy(&cfsPolicy);
+        RegisterPolicy(&edfPolicy);
+}
+
+/**
+ * @brief Add a policy to the registry
+ *
+ * @param policy the prototype of the policy, it has to outlive the registry
+ */
+void RegisterPolicy(const policy_t *policy)
+{
+        if (numPolicies == POLICY_MAX)
+        {
+                fprintf(stderr, "policy: can't register %s, the registry is full\n", policy->name);
+                return;
+        }
+        policies[numPolicies++] = policy;
+}
+
+/**
+ * @brief Look a policy up by its name or by its number
+ *
+ * @param name the name of the policy or its number in the registry
+ * @return const policy_t* the prototype, NULL if there's no such policy
+ */
+const policy_t *FindPolicy(const char *name)
+{
+        RegisterBuiltinPolicies();
+
+        if (isdigit((unsigned char)name[0]))
+        {
+                int option = atoi(name);
+                return option < numPolicies ? policies[option] : NULL;
+        }
+
+        for (int i = 0; i < numPolicies; i++)
+        {
+                if (strcmp(policies[i]->name, name) == 0)
+                        return policies[i];
+        }
+        return NULL;
+}
+
+/**
+ * @brief Create an instance of a policy with its own run queue
+ *
+ * @param spec the policy name or number, optionally followed by ':' and its options
+ * @param quantum the quantum the user entered
+ * @return policy_t* the instance, NULL if there's no such policy or its options are wrong
+ */
+policy_t *CreatePolicy(const char *spec, int quantum)
+{
+        char name[POLICY_SPEC_SIZE];
+        const char *args = strchr(spec, ':');
+        size_t len = args ? (size_t)(args - spec) : strlen(spec);
+
+        if (len >= sizeof(name))
+                return NULL;
+        memcpy(name, spec, len);
+        name[len] = '\0';
+
+        const policy_t *proto = FindPolicy(name);
+        if (proto == NULL)
+                return NULL;
+
+        policy_t *policy = (policy_t *)malloc(sizeof(policy_t));
+        *policy = *proto;
+        policy->data = NULL;
+        policy->nready = 0;
+
+        if (policy->init(policy, args ? args + 1 : "", quantum) != 0)
+        {
+                free(policy);
+                return NULL;
+        }
+        return policy;
+}
+
+/**
+ * @brief Ask the user for the scheduling policy and its quantum if it takes one
+ *
+ * @param who the program asking, for the messages
+ * @param spec filled with the policy name or number and its options, POLICY_SPEC_SIZE bytes
+ * @param quantum filled with the quantum, 0 if the policy doesn't take one
+ */
+void ReadPolicy(const char *who, char *spec, int *quantum)
+{
+        RegisterBuiltinPolicies();
+
+        printf("please enter the scheduling algorithm:\n");
+        for (int i = 0; i < numPolicies; i++)
+                printf("%d: %s\n", i, policies[i]->description);
+        printf("or its name followed by ':' and its options\n");
+
+        if (fgets(spec, POLICY_SPEC_SIZE, stdin) == NULL)
+        {
+                fprintf(stderr, "%s: error when reading sched option\n", who);
+                exit(EXIT_FAILURE);
+        }
+        spec[strcspn(spec, "\r\n")] = '\0';
+
+        *quantum = 0;
+        const char *colon = strchr(spec, ':');
+        char name[POLICY_SPEC_SIZE];
+        snprintf(name, sizeof(name), "%.*s", colon ? (int)(colon - spec) : (int)strlen(spec), spec);
+
+        const policy_t *policy = FindPolicy(name);
+        if (policy == NULL)
+        {
+                fprintf(stderr, "%s: unknown scheduling algorithm %s\n", who, spec);
+                exit(EXIT_FAILURE);
+        }
+
+        if (policy->usesQuantum)
+        {
+                printf("%s: please enter the quantum\n", who);
+
+                char value[100];
+                if (fgets(value, 100, stdin) == NULL)
+                {
+                        fprintf(stderr, "%s: error when reading quantum option\n", who);
+                        exit(EXIT_FAILURE);
+                }
+
+                *quantum = atoi(value);
+        }
+}
@@ -0,0 +1,59 @@
+/**
+ * @file policy.h
+ * @brief The interface every scheduling policy implements and the registry
+ * the policies are looked up by name in.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#ifndef _POLICY_H
+#define _POLICY_H
+
+#include <stdio.h>
+#include "pcb.h"
+
+#define POLICY_MAX 16
+#define RQSZ 1000 /**< initial capacity of the run queues, they grow when it's reached */
+#define POLICY_SPEC_SIZE 100
+
+/**
+ * @brief A scheduling policy. The registry holds one prototype per policy,
+ * CreatePolicy() copies it and init() builds the instance's own run queue.
+ * The engine owns the running PCB, the policy owns the ones that wait.
+ * With several CPUs every CPU has its own instance.
+ */
+typedef struct policy
+{
+        const char *name;        /**< what the policy is registered and looked up by */
+        const char *description; /**< shown when the user picks a policy */
+        int usesQuantum;         /**< 1 if the user has to enter a quantum */
+
+        /** parse the options after the ':' of the spec and create the run queue, 0 on success */
+        int (*init)(struct policy *self, const char *args, int quantum);
+        /** a PCB arrived and is ready */
+        void (*on_arrival)(struct policy *self, PCB *pcb, int curTime);
+        /** the running PCB ran elapsed more ticks, return 1 to preempt it */
+        int (*on_tick)(struct policy *self, PCB *running, int elapsed, int curTime);
+        /** remove and return the next PCB to run, NULL if there's none */
+        PCB *(*pick_next)(struct policy *self, int curTime);
+        /** the running PCB was stopped, take it back */
+        void (*on_preempt)(struct policy *self, PCB *pcb, int curTime);
+        /** the running PCB finished */
+        void (*on_finish)(struct policy *self, PCB *pcb, int curTime);
+        /** remove a waiting PCB for an idle CPU, it's handed to that CPU's policy with on_arrival */
+        PCB *(*steal)(struct policy *self, int curTime);
+        /** optional, the next tick the policy wants to preempt running at, INT_MAX if none */
+        int (*next_event)(struct policy *self, PCB *running, int curTime);
+        /** optional, extra lines for scheduler.perf */
+        void (*report)(struct policy *self, FILE *perf);
+
+        void *data; /**< the instance's run queue and state */
+        int nready; /**< PCBs in the run queue, kept by the engine */
+} policy_t;
+
+void RegisterPolicy(const policy_t *policy);
+const policy_t *FindPolicy(const char *name);
+policy_t *CreatePolicy(const char *spec, int quantum);
+void ReadPolicy(const char *who, char *spec, int *quantum);
+
+#endif /* _POLICY_H */
@@ -0,0 +1,258 @@
+/**
+ * @file policy_cfs.c
+ * @brief Completely fair scheduling. Every PCB has a virtual runtime that grows
+ * with its run time divided by the weight of its priority, the PCB with the
+ * smallest one runs next. The run queue is a red-black tree keyed on vruntime.
+ * Every target latency ticks each runnable PCB gets a slice in proportion to its
+ * weight, but never less than the minimum granularity.
+ * The options are "latency=6,granularity=1".
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "policy.h"
+#include "rb_tree.h"
+
+#define CFS_DEFAULT_LATENCY 6
+#define CFS_DEFAULT_GRANULARITY 1
+#define CFS_NICE_0_WEIGHT 1024
+#define CFS_VRUNTIME_SHIFT 10 /**< vruntime is kept in 1/1024 ticks */
+
+/**
+ * @brief The weight of priorities 0 to 19, every priority gets ~25% less CPU
+ * than the one above it. The lower priorities take the weight of 19.
+ */
+const int cfsWeights[] = {
+        1024, 820, 655, 526, 423, 335, 272, 215, 172, 137,
+        110, 87, 70, 56, 45, 36, 29, 23, 18, 15};
+
+#define CFS_NUM_WEIGHTS (int)(sizeof(cfsWeights) / sizeof(cfsWeights[0]))
+
+typedef struct
+{
+        rb_tree tree;
+        int latency;      /**< the period every runnable PCB runs once in */
+        int granularity;  /**< the shortest slice */
+        long load;        /**< the weights of the waiting and the running PCBs */
+        long minVruntime; /**< new PCBs start at it, it never goes down */
+        PCB *current;     /**< the PCB the engine runs, NULL if it's idle */
+        int charged;      /**< the tick current's vruntime is charged up to */
+        int sliceUsed;    /**< ticks the running PCB ran since it got the CPU */
+        int waited;       /**< 1 if others were waiting at the end of the last tick */
+
+        long picks;
+        int maxRunnable;
+        int maxDepth;
+} cfs_t;
+
+int CFSWeight(PCB *pcb)
+{
+        int prio = pcb->priority < 0 ? 0 : pcb->priority;
+        return cfsWeights[prio < CFS_NUM_WEIGHTS ? prio : CFS_NUM_WEIGHTS - 1];
+}
+
+/**
+ * @brief The ticks the running PCB gets before the next one, its share of
+ * the target latency
+ */
+int CFSSlice(cfs_t *cfs, PCB *running)
+{
+        int slice = (int)(cfs->latency * (long)CFSWeight(running) / cfs->load);
+        return slice > cfs->granularity ? slice : cfs->granularity;
+}
+
+/**
+ * @brief Charge the running PCB for the ticks it ran and move minVruntime up.
+ * It's charged before an arrival reads minVruntime too, so the same ticks
+ * give the same vruntimes whether or not the clock visited the ticks between.
+ */
+void CFSUpdate(cfs_t *cfs, int curTime)
+{
+        if (cfs->current == NULL)
+                return;
+
+        PCB *running = cfs->current;
+        long elapsed = curTime - cfs->charged;
+        running->vruntime += (elapsed << CFS_VRUNTIME_SHIFT) * CFS_NICE_0_WEIGHT / CFSWeight(running);
+        cfs->charged = curTime;
+
+        long minVruntime = running->vruntime;
+        if (cfs->tree.leftmost != NULL && cfs->tree.leftmost->key < minVruntime)
+                minVruntime = cfs->tree.leftmost->key;
+        if (minVruntime > cfs->minVruntime)
+                cfs->minVruntime = minVruntime;
+}
+
+void CFSEnqueue(cfs_t *cfs, PCB *pcb)
+{
+        pcb->runNode.key = pcb->vruntime;
+        int depth = RBInsert(&cfs->tree, &pcb->runNode);
+        if (depth > cfs->maxDepth)
+                cfs->maxDepth = depth;
+        if (cfs->tree.size > cfs->maxRunnable)
+                cfs->maxRunnable = cfs->tree.size;
+}
+
+int CFSInit(policy_t *self, const char *args, int quantum)
+{
+        cfs_t *cfs = (cfs_t *)calloc(1, sizeof(cfs_t));
+        char options[POLICY_SPEC_SIZE];
+
+        RBInit(&cfs->tree);
+        cfs->latency = CFS_DEFAULT_LATENCY;
+        cfs->granularity = CFS_DEFAULT_GRANULARITY;
+
+        snprintf(options, sizeof(options), "%s", args);
+        char *save, *option = strtok_r(options, ",", &save);
+        while (option != NULL)
+        {
+                char *value = strchr(option, '=');
+                if (value != NULL)
+                        *value++ = '\0';
+
+                if (value != NULL && strcmp(option, "latency") == 0)
+                        cfs->latency = atoi(value);
+                else if (value != NULL && strcmp(option, "granularity") == 0)
+                        cfs->granularity = atoi(value);
+                else
+                {
+                        fprintf(stderr, "cfs: unknown option %s\n", option);
+                        free(cfs);
+                        return -1;
+                }
+
+                option = strtok_r(NULL, ",", &save);
+        }
+
+        if (cfs->latency < 1 || cfs->granularity < 1)
+        {
+                fprintf(stderr, "cfs: wrong options %s\n", args);
+                free(cfs);
+                return -1;
+        }
+
+        self->data = cfs;
+        return 0;
+}
+
+void CFSOnArrival(policy_t *self, PCB *pcb, int curTime)
+{
+        cfs_t *cfs = self->data;
+
+        CFSUpdate(cfs, curTime);
+
+        // a new PCB starts with the ones that are behind, it doesn't get the time it
+        // wasn't there for. One from another CPU keeps how far it was ahead of them.
+        pcb->vruntime += cfs->minVruntime;
+        cfs->load += CFSWeight(pcb);
+        CFSEnqueue(cfs, pcb);
+}
+
+int CFSOnTick(policy_t *self, PCB *running, int elapsed, int curTime)
+{
+        cfs_t *cfs = self->data;
+
+        CFSUpdate(cfs, curTime);
+
+        if (cfs->tree.size == 0)
+        {
+                cfs->waited = 0;
+                return 0;
+        }
+
+        // the slice only runs down while others are waiting
+        cfs->sliceUsed = cfs->waited ? cfs->sliceUsed + elapsed : 0;
+        cfs->waited = 1;
+        if (cfs->sliceUsed < CFSSlice(cfs, running))
+                return 0;
+
+        // it would be picked again if it's still the furthest behind, give it another slice
+        if (running->vruntime < cfs->tree.leftmost->key)
+        {
+                cfs->sliceUsed = 0;
+                return 0;
+        }
+        return 1;
+}
+
+PCB *CFSPickNext(policy_t *self, int curTime)
+{
+        cfs_t *cfs = self->data;
+        rb_node *first = cfs->tree.leftmost;
+
+        if (first == NULL)
+                return NULL;
+
+        RBErase(&cfs->tree, first);
+        cfs->picks++;
+        cfs->sliceUsed = 0;
+        cfs->waited = cfs->tree.size != 0;
+        cfs->current = RB_ENTRY(first, PCB, runNode);
+        cfs->charged = curTime;
+        return cfs->current;
+}
+
+PCB *CFSSteal(policy_t *self, int curTime)
+{
+        cfs_t *cfs = self->data;
+        rb_node *first = cfs->tree.leftmost;
+
+        if (first == NULL)
+                return NULL;
+
+        PCB *pcb = RB_ENTRY(first, PCB, runNode);
+        RBErase(&cfs->tree, first);
+        cfs->load -= CFSWeight(pcb);
+        pcb->vruntime -= cfs->minVruntime;
+        return pcb;
+}
+
+void CFSOnPreempt(policy_t *self, PCB *pcb, int curTime)
+{
+        cfs_t *cfs = self->data;
+        cfs->current = NULL;
+        CFSEnqueue(cfs, pcb);
+}
+
+void CFSOnFinish(policy_t *self, PCB *pcb, int curTime)
+{
+        cfs_t *cfs = self->data;
+        CFSUpdate(cfs, curTime);
+        cfs->current = NULL;
+        cfs->load -= CFSWeight(pcb);
+}
+
+int CFSNextEvent(policy_t *self, PCB *running, int curTime)
+{
+        cfs_t *cfs = self->data;
+        if (cfs->tree.size == 0)
+                return INT_MAX;
+        return curTime + CFSSlice(cfs, running) - cfs->sliceUsed;
+}
+
+void CFSReport(policy_t *self, FILE *perf)
+{
+        cfs_t *cfs = self->data;
+
+        fprintf(perf, "CFS picks = %ld\n", cfs->picks);
+        fprintf(perf, "CFS max runnable = %d\n", cfs->maxRunnable);
+        fprintf(perf, "CFS max tree depth = %d\n", cfs->maxDepth);
+}
+
+const policy_t cfsPolicy = {
+        .name = "cfs",
+        .description = "Completely fair scheduler (CFS)",
+        .init = CFSInit,
+        .on_arrival = CFSOnArrival,
+        .on_tick = CFSOnTick,
+        .pick_next = CFSPickNext,
+        .on_preempt = CFSOnPreempt,
+        .on_finish = CFSOnFinish,
+        .steal = CFSSteal,
+        .next_event = CFSNextEvent,
+        .report = CFSReport,
+};
@@ -0,0 +1,90 @@
+/**
+ * @file policy_edf.c
+ * @brief Earliest Deadline First. The run queue is a red-black tree keyed on
+ * the absolute deadline, a job with an earlier deadline preempts the running
+ * one. Jobs without a deadline only run when no job with one is waiting.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include "policy.h"
+#include "rb_tree.h"
+
+typedef struct
+{
+        rb_tree tree;
+        long preemptions;
+} edf_t;
+
+long EDFKey(PCB *pcb)
+{
+        return pcb->deadline > 0 ? pcb->deadline : LONG_MAX;
+}
+
+int EDFInit(policy_t *self, const char *args, int quantum)
+{
+        edf_t *edf = (edf_t *)calloc(1, sizeof(edf_t));
+        RBInit(&edf->tree);
+        self->data = edf;
+        return 0;
+}
+
+void EDFOnArrival(policy_t *self, PCB *pcb, int curTime)
+{
+        edf_t *edf = self->data;
+        pcb->runNode.key = EDFKey(pcb);
+        RBInsert(&edf->tree, &pcb->runNode);
+}
+
+int EDFOnTick(policy_t *self, PCB *running, int elapsed, int curTime)
+{
+        edf_t *edf = self->data;
+
+        if (edf->tree.leftmost == NULL || edf->tree.leftmost->key >= EDFKey(running))
+                return 0;
+
+        edf->preemptions++;
+        return 1;
+}
+
+PCB *EDFPickNext(policy_t *self, int curTime)
+{
+        edf_t *edf = self->data;
+        rb_node *first = edf->tree.leftmost;
+
+        if (first == NULL)
+                return NULL;
+        RBErase(&edf->tree, first);
+        return RB_ENTRY(first, PCB, runNode);
+}
+
+void EDFOnPreempt(policy_t *self, PCB *pcb, int curTime)
+{
+        EDFOnArrival(self, pcb, curTime);
+}
+
+void EDFOnFinish(policy_t *self, PCB *pcb, int curTime)
+{
+}
+
+void EDFReport(policy_t *self, FILE *perf)
+{
+        edf_t *edf = self->data;
+        fprintf(perf, "EDF preemptions = %ld\n", edf->preemptions);
+}
+
+const policy_t edfPolicy = {
+        .name = "edf",
+        .description = "Earliest deadline first (EDF)",
+        .init = EDFInit,
+        .on_arrival = EDFOnArrival,
+        .on_tick = EDFOnTick,
+        .pick_next = EDFPickNext,
+        .on_preempt = EDFOnPreempt,
+        .on_finish = EDFOnFinish,
+        .steal = EDFPickNext,
+        .report = EDFReport,
+};
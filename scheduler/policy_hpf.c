@@ -0,0 +1,92 @@
+/**
+ * @file policy_hpf.c
+ * @brief Non-preemptive Highest Priority First, the running PCB always runs to
+ * completion. The priorities that fit a bucket queue go there, O(1) and first
+ * in first out among equal priorities, the others to a min-heap.
+ * The option "queue=heap" puts all of them in the heap.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "policy.h"
+#include "priority_queue.h"
+#include "bucket_queue.h"
+
+typedef struct
+{
+        struct BucketQueue *buckets; /**< NULL if everything goes to the heap */
+        struct Heap *heap;
+} hpf_t;
+
+int HPFInit(policy_t *self, const char *args, int quantum)
+{
+        hpf_t *hpf = (hpf_t *)malloc(sizeof(hpf_t));
+
+        if (strcmp(args, "queue=heap") == 0)
+                hpf->buckets = NULL;
+        else if (args[0] == '\0' || strcmp(args, "queue=bucket") == 0)
+                hpf->buckets = CreateBucketQueue(RQSZ);
+        else
+        {
+                fprintf(stderr, "hpf: unknown option %s\n", args);
+                free(hpf);
+                return -1;
+        }
+
+        hpf->heap = CreateHeap(RQSZ);
+        self->data = hpf;
+        return 0;
+}
+
+void HPFOnArrival(policy_t *self, PCB *pcb, int curTime)
+{
+        hpf_t *hpf = self->data;
+
+        if (hpf->buckets != NULL && BucketKeyFits(pcb->priority))
+                BucketInsert(hpf->buckets, pcb, pcb->priority);
+        else
+                InsertValue(hpf->heap, pcb, pcb->priority);
+}
+
+int HPFOnTick(policy_t *self, PCB *running, int elapsed, int curTime)
+{
+        return 0;
+}
+
+PCB *HPFPickNext(policy_t *self, int curTime)
+{
+        hpf_t *hpf = self->data;
+
+        // the two never have the same priority
+        if (hpf->buckets != NULL && !BucketIsEmpty(hpf->buckets) &&
+            (HeapIsEmpty(hpf->heap) || BucketMinKey(hpf->buckets) < MinimumKey(hpf->heap)))
+                return BucketExtractMin(hpf->buckets);
+
+        if (HeapIsEmpty(hpf->heap))
+                return NULL;
+        return ExtractMin(hpf->heap);
+}
+
+void HPFOnPreempt(policy_t *self, PCB *pcb, int curTime)
+{
+        HPFOnArrival(self, pcb, curTime);
+}
+
+void HPFOnFinish(policy_t *self, PCB *pcb, int curTime)
+{
+}
+
+const policy_t hpfPolicy = {
+        .name = "hpf",
+        .description = "Non-preemptive Highest Priority First (NHPF)",
+        .init = HPFInit,
+        .on_arrival = HPFOnArrival,
+        .on_tick = HPFOnTick,
+        .pick_next = HPFPickNext,
+        .on_preempt = HPFOnPreempt,
+        .on_finish = HPFOnFinish,
+        .steal = HPFPickNext,
+};
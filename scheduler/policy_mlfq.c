@@ -0,0 +1,293 @@
+/**
+ * @file policy_mlfq.c
+ * @brief Multi-level feedback queue. Every level is a FIFO with its own quantum,
+ * a PCB arrives at the top level and goes one level down once it used up the
+ * quantum of its level. Every boost ticks all the PCBs go back to the top.
+ * The options are "levels=3,quanta=2/4/8,boost=50", by default the quantum of
+ * a level is twice the one above it starting from the quantum the user entered.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "policy.h"
+#include "ready_queue.h"
+
+#define MLFQ_MAX_LEVELS 16
+#define MLFQ_DEFAULT_LEVELS 3
+#define MLFQ_DEFAULT_BOOST 50
+
+typedef struct
+{
+        int levels;
+        struct Queue *queues[MLFQ_MAX_LEVELS];
+        int quanta[MLFQ_MAX_LEVELS];
+        int boost;    /**< the PCBs are boosted at every multiple of it, 0 to never boost */
+        PCB *current; /**< the PCB the engine runs, NULL if it's idle */
+        int charged;  /**< the tick current's run time is charged up to */
+
+        long ran[MLFQ_MAX_LEVELS];       /**< ticks run at every level */
+        long dispatches[MLFQ_MAX_LEVELS]; /**< times a PCB of the level got the CPU */
+        long demotions[MLFQ_MAX_LEVELS];  /**< PCBs that left the level downwards */
+        long boosts;
+} mlfq_t;
+
+/**
+ * @brief Parse the quanta list, e.g. "2/4/8"
+ *
+ * @return int the number of quanta, -1 if one of them isn't positive
+ */
+int MLFQParseQuanta(mlfq_t *mlfq, char *list)
+{
+        int n = 0;
+        char *save, *value = strtok_r(list, "/", &save);
+        while (value != NULL && n < MLFQ_MAX_LEVELS)
+        {
+                mlfq->quanta[n] = atoi(value);
+                if (mlfq->quanta[n] <= 0)
+                        return -1;
+                n++;
+                value = strtok_r(NULL, "/", &save);
+        }
+        return n;
+}
+
+int MLFQInit(policy_t *self, const char *args, int quantum)
+{
+        mlfq_t *mlfq = (mlfq_t *)calloc(1, sizeof(mlfq_t));
+        char options[POLICY_SPEC_SIZE];
+        int nquanta = 0;
+
+        mlfq->levels = MLFQ_DEFAULT_LEVELS;
+        mlfq->boost = MLFQ_DEFAULT_BOOST;
+
+        snprintf(options, sizeof(options), "%s", args);
+        char *save, *option = strtok_r(options, ",", &save);
+        while (option != NULL)
+        {
+                char *value = strchr(option, '=');
+                if (value == NULL)
+                        goto bad_option;
+                *value++ = '\0';
+
+                if (strcmp(option, "levels") == 0)
+                        mlfq->levels = atoi(value);
+                else if (strcmp(option, "boost") == 0)
+                        mlfq->boost = atoi(value);
+                else if (strcmp(option, "quanta") == 0)
+                        nquanta = MLFQParseQuanta(mlfq, value);
+                else
+                        goto bad_option;
+
+                option = strtok_r(NULL, ",", &save);
+        }
+
+        if (nquanta < 0 || mlfq->levels < 1 || mlfq->levels > MLFQ_MAX_LEVELS || mlfq->boost < 0)
+        {
+                fprintf(stderr, "mlfq: wrong options %s\n", args);
+                free(mlfq);
+                return -1;
+        }
+
+        // the levels without a quantum double the one above them
+        if (nquanta == 0)
+                mlfq->quanta[nquanta++] = quantum > 0 ? quantum : 1;
+        for (int i = nquanta; i < mlfq->levels; i++)
+                mlfq->quanta[i] = mlfq->quanta[i - 1] * 2;
+
+        for (int i = 0; i < mlfq->levels; i++)
+                mlfq->queues[i] = CreateQueue(RQSZ);
+        self->data = mlfq;
+        return 0;
+
+bad_option:
+        fprintf(stderr, "mlfq: unknown option %s\n", option);
+        free(mlfq);
+        return -1;
+}
+
+/**
+ * @brief The top level that has a PCB waiting, levels if none is
+ */
+int MLFQTopLevel(mlfq_t *mlfq)
+{
+        int level = 0;
+        while (level < mlfq->levels && IsEmpty(mlfq->queues[level]))
+                level++;
+        return level;
+}
+
+/**
+ * @brief 1 if the running PCB or a waiting one is below the top level
+ */
+int MLFQBelowTop(mlfq_t *mlfq)
+{
+        if (mlfq->current != NULL && mlfq->current->level > 0)
+                return 1;
+        for (int i = 1; i < mlfq->levels; i++)
+        {
+                if (!IsEmpty(mlfq->queues[i]))
+                        return 1;
+        }
+        return 0;
+}
+
+/**
+ * @brief Move every PCB back to the top level if curTime is a boost tick. The
+ * lower levels are appended to the top one in order so none of them jumps ahead.
+ * Boosts are only counted when they moved something, the ticks nothing was
+ * below the top are skipped by the virtual clock.
+ */
+void MLFQBoost(mlfq_t *mlfq, int curTime)
+{
+        if (mlfq->boost == 0 || curTime % mlfq->boost != 0 || !MLFQBelowTop(mlfq))
+                return;
+        mlfq->boosts++;
+
+        for (int i = 1; i < mlfq->levels; i++)
+        {
+                while (!IsEmpty(mlfq->queues[i]))
+                {
+                        PCB *pcb = Dequeue(mlfq->queues[i]);
+                        pcb->level = 0;
+                        pcb->quantumUsed = 0;
+                        Enqueue(mlfq->queues[0], pcb);
+                }
+        }
+
+        if (mlfq->current != NULL)
+        {
+                mlfq->current->level = 0;
+                mlfq->current->quantumUsed = 0;
+        }
+}
+
+void MLFQOnArrival(policy_t *self, PCB *pcb, int curTime)
+{
+        mlfq_t *mlfq = self->data;
+
+        // a PCB that moved from another CPU keeps its level
+        Enqueue(mlfq->queues[pcb->level], pcb);
+}
+
+int MLFQOnTick(policy_t *self, PCB *running, int elapsed, int curTime)
+{
+        mlfq_t *mlfq = self->data;
+        int expired = 0;
+
+        // charge the ticks to the levels they were run at
+        while (elapsed > 0)
+        {
+                int level = running->level;
+                int left = mlfq->quanta[level] - running->quantumUsed;
+                int used = elapsed < left ? elapsed : left;
+
+                mlfq->ran[level] += used;
+                running->quantumUsed += used;
+                elapsed -= used;
+
+                if (running->quantumUsed == mlfq->quanta[level])
+                {
+                        expired = 1;
+                        running->quantumUsed = 0;
+                        if (level + 1 < mlfq->levels)
+                        {
+                                mlfq->demotions[level]++;
+                                running->level++;
+                        }
+                }
+        }
+
+        mlfq->charged = curTime;
+        MLFQBoost(mlfq, curTime);
+
+        // a PCB of the same level waits its turn only when the quantum is over
+        int top = MLFQTopLevel(mlfq);
+        return expired ? top <= running->level : top < running->level;
+}
+
+PCB *MLFQPickNext(policy_t *self, int curTime)
+{
+        mlfq_t *mlfq = self->data;
+
+        MLFQBoost(mlfq, curTime);
+
+        int level = MLFQTopLevel(mlfq);
+        if (level == mlfq->levels)
+                return NULL;
+
+        mlfq->dispatches[level]++;
+        mlfq->charged = curTime;
+        mlfq->current = Dequeue(mlfq->queues[level]);
+        return mlfq->current;
+}
+
+PCB *MLFQSteal(policy_t *self, int curTime)
+{
+        mlfq_t *mlfq = self->data;
+        int level = MLFQTopLevel(mlfq);
+        return level == mlfq->levels ? NULL : Dequeue(mlfq->queues[level]);
+}
+
+void MLFQOnPreempt(policy_t *self, PCB *pcb, int curTime)
+{
+        mlfq_t *mlfq = self->data;
+
+        // a PCB stopped by a higher level keeps what it used of its quantum
+        mlfq->current = NULL;
+        Enqueue(mlfq->queues[pcb->level], pcb);
+}
+
+void MLFQOnFinish(policy_t *self, PCB *pcb, int curTime)
+{
+        mlfq_t *mlfq = self->data;
+
+        // it finished before its quantum did, so all in its level
+        mlfq->ran[pcb->level] += curTime - mlfq->charged;
+        mlfq->current = NULL;
+}
+
+int MLFQNextEvent(policy_t *self, PCB *running, int curTime)
+{
+        mlfq_t *mlfq = self->data;
+        int next = curTime + mlfq->quanta[running->level] - running->quantumUsed;
+
+        // a boost only changes something when a PCB is below the top level
+        if (mlfq->boost != 0 && MLFQBelowTop(mlfq))
+        {
+                int boost = (curTime / mlfq->boost + 1) * mlfq->boost;
+                if (boost < next)
+                        next = boost;
+        }
+        return next;
+}
+
+void MLFQReport(policy_t *self, FILE *perf)
+{
+        mlfq_t *mlfq = self->data;
+
+        for (int i = 0; i < mlfq->levels; i++)
+        {
+                fprintf(perf, "MLFQ level %d (quantum %d): ran %ld ticks, %ld switches, %ld demotions\n",
+                        i, mlfq->quanta[i], mlfq->ran[i], mlfq->dispatches[i], mlfq->demotions[i]);
+        }
+        fprintf(perf, "MLFQ boosts = %ld\n", mlfq->boosts);
+}
+
+const policy_t mlfqPolicy = {
+        .name = "mlfq",
+        .description = "Multi-level feedback queue (MLFQ)",
+        .usesQuantum = 1,
+        .init = MLFQInit,
+        .on_arrival = MLFQOnArrival,
+        .on_tick = MLFQOnTick,
+        .pick_next = MLFQPickNext,
+        .on_preempt = MLFQOnPreempt,
+        .on_finish = MLFQOnFinish,
+        .steal = MLFQSteal,
+        .next_event = MLFQNextEvent,
+        .report = MLFQReport,
+};
@@ -0,0 +1,99 @@
+/**
+ * @file policy_rr.c
+ * @brief Round Robin. The run queue is a FIFO, the running PCB goes to its
+ * back once it used up its quantum while others were waiting.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#include <stdlib.h>
+#include <limits.h>
+#include "policy.h"
+#include "ready_queue.h"
+
+typedef struct
+{
+        struct Queue *queue;
+        int quantum;     /**< the quantum of every process */
+        int currQuantum; /**< remaining time for the current quantum */
+        int waited;      /**< 1 if others were waiting at the end of the last tick */
+} rr_t;
+
+int RRInit(policy_t *self, const char *args, int quantum)
+{
+        rr_t *rr = (rr_t *)malloc(sizeof(rr_t));
+        rr->queue = CreateQueue(RQSZ);
+        rr->quantum = quantum;
+        rr->currQuantum = quantum;
+        rr->waited = 0;
+        self->data = rr;
+        return 0;
+}
+
+void RROnArrival(policy_t *self, PCB *pcb, int curTime)
+{
+        rr_t *rr = self->data;
+        Enqueue(rr->queue, pcb);
+}
+
+int RROnTick(policy_t *self, PCB *running, int elapsed, int curTime)
+{
+        rr_t *rr = self->data;
+
+        if (IsEmpty(rr->queue))
+        {
+                rr->waited = 0;
+                return 0;
+        }
+
+        // the quantum only runs down while others are waiting
+        rr->currQuantum -= rr->waited ? elapsed : 1;
+        rr->waited = 1;
+        return rr->currQuantum <= 0;
+}
+
+PCB *RRPickNext(policy_t *self, int curTime)
+{
+        rr_t *rr = self->data;
+        PCB *next = Dequeue(rr->queue);
+
+        rr->currQuantum = rr->quantum;
+        rr->waited = !IsEmpty(rr->queue);
+        return next;
+}
+
+PCB *RRSteal(policy_t *self, int curTime)
+{
+        rr_t *rr = self->data;
+        return Dequeue(rr->queue);
+}
+
+void RROnPreempt(policy_t *self, PCB *pcb, int curTime)
+{
+        rr_t *rr = self->data;
+        Enqueue(rr->queue, pcb);
+}
+
+void RROnFinish(policy_t *self, PCB *pcb, int curTime)
+{
+}
+
+int RRNextEvent(policy_t *self, PCB *running, int curTime)
+{
+        rr_t *rr = self->data;
+        return IsEmpty(rr->queue) ? INT_MAX : curTime + rr->currQuantum;
+}
+
+const policy_t rrPolicy = {
+        .name = "rr",
+        .description = "Round robin (RR)",
+        .usesQuantum = 1,
+        .init = RRInit,
+        .on_arrival = RROnArrival,
+        .on_tick = RROnTick,
+        .pick_next = RRPickNext,
+        .on_preempt = RROnPreempt,
+        .on_finish = RROnFinish,
+        .steal = RRSteal,
+        .next_event = RRNextEvent,
+};
@@ -0,0 +1,62 @@
+/**
+ * @file policy_srtn.c
+ * @brief Shortest Remaining Time Next. The run queue is a min-heap keyed on
+ * the remaining time, a new arrival preempts the running PCB if it's shorter.
+ * The remaining times of the waiting PCBs don't change, so their keys stay put.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#include <stdlib.h>
+#include "policy.h"
+#include "priority_queue.h"
+
+int SRTNInit(policy_t *self, const char *args, int quantum)
+{
+        self->data = CreateHeap(RQSZ);
+        return 0;
+}
+
+void SRTNOnArrival(policy_t *self, PCB *pcb, int curTime)
+{
+        InsertValue(self->data, pcb, pcb->remainingTime);
+}
+
+int SRTNOnTick(policy_t *self, PCB *running, int elapsed, int curTime)
+{
+        struct Heap *queue = self->data;
+
+        if (HeapIsEmpty(queue))
+                return 0;
+
+        // Context Switching
+        return running->remainingTime > MinimumKey(queue);
+}
+
+PCB *SRTNPickNext(policy_t *self, int curTime)
+{
+        if (HeapIsEmpty(self->data))
+                return NULL;
+        return ExtractMin(self->data);
+}
+
+void SRTNOnPreempt(policy_t *self, PCB *pcb, int curTime)
+{
+        InsertValue(self->data, pcb, pcb->remainingTime);
+}
+
+void SRTNOnFinish(policy_t *self, PCB *pcb, int curTime)
+{
+}
+
+const policy_t srtnPolicy = {
+        .name = "srtn",
+        .description = "shortest remaining time next (SRTN)",
+        .init = SRTNInit,
+        .on_arrival = SRTNOnArrival,
+        .on_tick = SRTNOnTick,
+        .pick_next = SRTNPickNext,
+        .on_preempt = SRTNOnPreempt,
+        .on_finish = SRTNOnFinish,
+        .steal = SRTNPickNext,
+};
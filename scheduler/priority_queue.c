@@ -1,140 +1,174 @@
 /** 
- * @file priority_queue.h
+ * @file priority_queue.c
  * @author Mohamed Abo-Bakr
- * @brief Implementation of priority queue data structure using min-heap
+ * @brief Implementation of priority queue data structure using an indexed 4-ary min-heap
  **/ 
 
 #include <stdio.h>
-#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
 #include "pcb.h"
 #include "priority_queue.h"
 
+#define HEAP_ARITY 4
+#define HEAP_LINE 64 /**< the cache line the children of an entry fit in */
 
 /**
- * \fn 
- * @brief function to Swap PCB pointers
+ * @brief Allocate room for capacity entries. The children of i are 4i+1 to
+ * 4i+4, so entries is shifted by 3 to start every group of children on a line.
  */
-void Swap(PCB **x, PCB **y)
+static heap_entry *AllocEntries(int capacity, heap_entry **block)
 {
-	PCB* temp = *x;
-	*x = *y;
-	*y = temp;
+	size_t bytes = sizeof(heap_entry) * (capacity + HEAP_ARITY - 1);
+	bytes = (bytes + HEAP_LINE - 1) / HEAP_LINE * HEAP_LINE;
+
+	*block = (heap_entry *)aligned_alloc(HEAP_LINE, bytes);
+	if (*block == NULL)
+	{
+		perror("priority queue: can't allocate the heap");
+		exit(EXIT_FAILURE);
+	}
+	return *block + HEAP_ARITY - 1;
 }
 
-/** 
- * @brief Returns top element (root) without removing it
- */
-PCB* Minimum(struct Queue *hp)
+struct Heap *CreateHeap(int capacity)
 {
-	return hp->array[0];
+	struct Heap *hp = (struct Heap *)malloc(sizeof(struct Heap));
+	hp->size = 0;
+	hp->seq = 0;
+	hp->capacity = capacity > 0 ? capacity : 1;
+	hp->entries = AllocEntries(hp->capacity, &hp->block);
+	return hp;
 }
 
+int HeapIsEmpty(struct Heap *hp)
+{
+	return hp->size == 0;
+}
+
+static inline int Less(const heap_entry *a, const heap_entry *b)
+{
+	return a->key < b->key || (a->key == b->key && (int)(a->seq - b->seq) < 0);
+}
 
 /**
- * @brief Extract top element and remove it
+ * @brief Move the entry at i up until its parent is smaller
  */
-PCB* ExtractMin(struct Queue *hp)
+static void SiftUp(struct Heap *hp, int i)
 {
-	int N = hp->size;
-	if (N == 0){
-		printf("Can’t remove element as queue is empty");
-		return 0;
+	heap_entry *entries = hp->entries;
+	heap_entry entry = entries[i];
+
+	while (i > 0)
+	{
+		int parent = (i - 1) / HEAP_ARITY;
+		if (!Less(&entry, &entries[parent]))
+			break;
+		entries[i] = entries[parent];
+		i = parent;
 	}
 
-	// save the value
-	PCB *min = hp->array[0];
-
-	// replace it with last element in heap
-	hp->array[0] = hp->array[N - 1];
-
-	// Decrease the size and call min-heapify for root
-	hp->size = N - 1;
-	MinHeapify(hp, 0);
-
-	// Return old top
-	return min;
+	entries[i] = entry;
 }
 
-
-
-void MinHeapify(struct Queue *hp, int parent)
+/**
+ * @brief Move the entry at i down until its children are bigger
+ */
+static void SiftDown(struct Heap *hp, int i)
 {
-	PCB **arr = hp->array;
-	int size = hp->size, min;
-	int left = 2 * parent + 1;
-	int right = 2 * parent + 2;
-
-	// min = minimum of left, right and parent
-	if (left < size && arr[left]->priority < arr[parent]->priority)
-		min = left;
-	else
-		min = parent;
-
-	if (right < size && arr[right]->priority < arr[min]->priority)
-		min = right;
+	heap_entry *entries = hp->entries;
+	heap_entry entry = entries[i];
+	int size = hp->size;
+
+	while (1)
+	{
+		int first = HEAP_ARITY * i + 1;
+		if (first >= size)
+			break;
+
+		int last = first + HEAP_ARITY < size ? first + HEAP_ARITY : size;
+		int min = first;
+		for (int child = first + 1; child < last; child++)
+		{
+			if (Less(&entries[child], &entries[min]))
+				min = child;
+		}
+
+		if (!Less(&entries[min], &entry))
+			break;
+		entries[i] = entries[min];
+		i = min;
+	}
 
+	entries[i] = entry;
+}
 
-	if (min != parent){
-		// Swap pointers
-		Swap(&arr[parent], &arr[min]);
+/** 
+ * @brief Returns top element (root) without removing it
+ */
+PCB *Minimum(struct Heap *hp)
+{
+	return hp->size ? hp->entries[0].pcb : NULL;
+}
 
-		// call heapify for the new min
-		MinHeapify(hp, min);
-	}
+/** 
+ * @brief Returns the key of the top element, the heap mustn't be empty
+ */
+int MinimumKey(struct Heap *hp)
+{
+	return hp->entries[0].key;
 }
 
 /**
- * @brief change priority of element
- * @param i index of element that we want to change
- * @param val new value
+ * @brief Extract top element and remove it, NULL if the heap is empty
  */
-void DecPriority(struct Queue *hp, int i, int val)
+PCB *ExtractMin(struct Heap *hp)
 {
-	PCB **array = hp->array;
-	if (val > array[i]->priority){
-		printf("Error: New value is more than current value\n");
-		return;
-	}
-
-	// Set the priority
-	array[i]->priority = val;
-
-	// while parent's priority is higher, Swap
-	while (i > 0 && array[(i - 1) / 2]->priority > array[i]->priority){
-		Swap(&array[(i - 1) / 2], &array[i]);
-		i = (i - 1) / 2;
+	if (hp->size == 0)
+		return NULL;
+
+	// the last entry fills the hole at the top
+	PCB *min = hp->entries[0].pcb;
+	if (--hp->size > 0)
+	{
+		hp->entries[0] = hp->entries[hp->size];
+		SiftDown(hp, 0);
 	}
+	return min;
 }
 
 /**
  * @brief Inserts a new PCB to the heap
- * @param pc pointer to the PCB
+ * @param pcb pointer to the PCB
+ * @param key what it's ordered by
  */ 
-void InsertValue(struct Queue *hp, PCB *pc)
+void InsertValue(struct Heap *hp, PCB *pcb, int key)
 {
-	if (hp->size == hp-> capacity) {
-		printf("Heap overflow");
-		return;
+	if (hp->size == hp->capacity)
+	{
+		heap_entry *block, *entries = AllocEntries(hp->capacity * 2, &block);
+		memcpy(entries, hp->entries, sizeof(heap_entry) * hp->size);
+		free(hp->block);
+		hp->block = block;
+		hp->entries = entries;
+		hp->capacity *= 2;
 	}
 
-	// assign the new pointer to first empty position
-	hp -> array[hp -> size] = pc;
-
-	// Insert with high priority then decrease priority to its value
-	int val = pc ->priority;
-	hp->array[hp->size] ->priority = INT_MAX;
-	hp->size = hp->size + 1;
-	DecPriority(hp, hp ->size - 1, val);
+	heap_entry *entry = &hp->entries[hp->size++];
+	entry->key = key;
+	entry->seq = hp->seq++;
+	entry->pcb = pcb;
+	SiftUp(hp, hp->size - 1);
 }
 
 /**
  * @brief Prints all entries in the priority queue (mainly for debugging)
  */ 
-void PrintAll(struct Queue *hp)
+void PrintAll(struct Heap *hp)
 {
   int size = hp->size;
   for (int i = 0; i < size; i++)
   {
-    printf("element %d is %d\n", i, hp->array[i]->priority);
+    printf("element %d is process %d with key %d\n", i, hp->entries[i].pcb->id, hp->entries[i].key);
   }
-}
\ No newline at end of file
+}
@@ -1,14 +1,39 @@
 #ifndef _PRIORITY_QUEUE_H
 #define _PRIORITY_QUEUE_H
 
-#include "ready_queue.h"
+#include "pcb.h"
 
-void Swap(PCB **x, PCB **y);
-PCB* Minimum(struct Queue *hp);
-PCB* ExtractMin(struct Queue *hp);
-void DecPriority(struct Queue *hp, int i, int val);
-void InsertValue(struct Queue *hp, PCB *pc);
-void MinHeapify(struct Queue *hp, int parent);
-void PrintAll(struct Queue *hp);
+/**
+ * @brief An entry of the heap. The key is kept next to the PCB pointer so
+ * comparing two entries never touches the PCBs.
+ */
+typedef struct
+{
+	int key;       /**< the smaller the earlier it comes out */
+	unsigned seq;  /**< insertion order, breaks the ties first in first out */
+	PCB *pcb;
+} heap_entry;
 
-#endif
\ No newline at end of file
+/**
+ * @brief A 4-ary min-heap, the four children of an entry share a cache line.
+ * The PCBs are only ever taken from the top, none of the policies changes the
+ * key of a waiting PCB.
+ */
+struct Heap
+{
+	int size;
+	int capacity;     /**< grows when it's full */
+	unsigned seq;
+	heap_entry *entries;
+	heap_entry *block;  /**< the allocation entries points into */
+};
+
+struct Heap *CreateHeap(int capacity);
+int HeapIsEmpty(struct Heap *hp);
+PCB *Minimum(struct Heap *hp);
+int MinimumKey(struct Heap *hp);
+PCB *ExtractMin(struct Heap *hp);
+void InsertValue(struct Heap *hp, PCB *pcb, int key);
+void PrintAll(struct Heap *hp);
+
+#endif
@@ -1,82 +1,77 @@
 #include "headers.h"
+#include "worker_pool.h"
 
 /* Modify this file as needed*/
 int remainingtime;
-bool blocked = 0;
 int curTime;
-
-void SigSleepHandler(int signum);
+// the cpu we run on picks our slot in the tick barrier
+int cpu;
 
 int main(int argc, char * argv[])
 {
-        signal(SIGSLP, SigSleepHandler);
-
-        key_t shmRemainingTime;
-        int* shmRemainingTimeAd;
-
-        shmRemainingTime = shmget(PRSHKEY, 4, 0644);
-        if (shmRemainingTime == -1) {
-                perror("Process: Failed to get the shared memory\n");
-                exit(EXIT_FAILURE);
-        }
-
-        shmRemainingTimeAd = (int *) shmat(shmRemainingTime, (void *)0, 0);
-        if ((long)shmRemainingTimeAd == -1) {
-                perror("Process: Error in attaching the shm in scheduler!\n");
-                exit(EXIT_FAILURE);
-        }
-
-
-        int semSchedProc = semget(SEM_SCHED_PROC_KEY, 1, 0666);
-
-        if (semSchedProc == -1)
-        {
-            perror("Error in create sem");
-            exit(-1);
-        }
+        // process.out slot, the scheduler hands us PCBs through our slot of the pool
+        int poolShm, slotIndex = argc > 1 ? atoi(argv[1]) : 0;
+        worker_pool_t *pool = attachWorkerPool(0, &poolShm);
+        worker_slot_t *slot = &pool->slots[slotIndex];
 
-        
         initClk();
 
-        //TODO it needs to get the remaining time from somewhere
-        //remainingtime = ??;
-
-        remainingtime = *shmRemainingTimeAd;
-        curTime = getClk();
+        while (1) {
+                // sleep until the scheduler hands us a PCB or lets us go
+                int ctl;
+                while ((ctl = __atomic_load_n(&slot->ctl, __ATOMIC_ACQUIRE)) == WORKER_IDLE)
+                        futexWait(&slot->ctl, WORKER_IDLE);
+                if (ctl == WORKER_EXIT)
+                        break;
+
+                // picked up, the tick it waits for next isn't part of the dispatch
+                recordDispatch(pool, slot->path, monoNs() - slot->dispatchNs);
+
+                remainingtime = slot->remaining;
+                curTime = slot->since;
+
+                while (remainingtime > 0) {
+                        int now = waitClk(curTime);
+
+                        // a stopped PCB sleeps until it's resumed, the ticks it spends
+                        // stopped aren't counted
+                        ctl = __atomic_load_n(&slot->ctl, __ATOMIC_ACQUIRE);
+                        if (ctl == WORKER_STOPPED) {
+                                futexWait(&slot->ctl, WORKER_STOPPED);
+                                continue;
+                        }
+                        // it was resumed, maybe on another cpu, before we saw it stopped
+                        if (slot->since > curTime)
+                                curTime = slot->since;
+                        cpu = slot->cpu;
+
+                        if (now > curTime) {
+                                // the virtual clock may have skipped some ticks
+                                remainingtime -= now - curTime;
+                                if (remainingtime < 0) remainingtime = 0;
+                                curTime = now;
+                                slot->remaining = remainingtime;
+                                if (remainingtime == 0) break;
+
+                                tickArrive(CLK_WORKER(cpu));
+                        }
+                }
 
+                // idle before the scheduler sees the PCB finished, it may hand us
+                // the next one in the same tick
+                __atomic_store_n(&slot->ctl, WORKER_IDLE, __ATOMIC_RELEASE);
 
-        while (remainingtime > 0) {
-                if (getClk() != curTime) {
-                        remainingtime -= 1;
-                        curTime = getClk();
-                        *shmRemainingTimeAd = remainingtime;
-			if (remainingtime == 0) break;
-			
-			up(semSchedProc);
-                }
-                while (blocked);
+                //notify the scheduler that this process is finished, the signal has
+                //to be pending before the scheduler gets past the barrier
+                kill(getppid(), SIGPF);
+                tickArrive(CLK_WORKER(cpu));
         }
-        
+
         //clear resources
-        if (shmdt(shmRemainingTimeAd) == -1) {
-              printf("process: error in detaching a shared memory\n");  
-        }
+        shmdt(pool);
+
         //detach the clock
         destroyClk(false);
 
-        //notify the scheduler that this process is finished
-        kill(getppid(), SIGPF);
-
-	up(semSchedProc);
-        
         return 0;
 }
-
-
-void SigSleepHandler(int signum)
-{
-        blocked = !blocked;
-        if (blocked == 0) curTime = getClk();
-        
-        signal(SIGSLP, SigSleepHandler);
-}
\ No newline at end of file
@@ -11,97 +11,86 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <inttypes.h>
+#include <string.h>
+#include <sys/eventfd.h>
 #include "headers.h"           /**< for dealing with clk module */
+#include "worker_pool.h"       /**< for WORKER_POOL_DEFAULT */
+#include "arrival_ring.h"      /**< for sending the processes */
 #include "process_generator.h" /**< for process_t */
+#include "trace.h"             /**< for OpenTrace */
+#include "policy.h"            /**< for ReadPolicy */
 
-key_t msgqid;
-
-struct msgbuff
-{
-        long mtype;
-        process_t proc;
-};
+int ringShm;
+arrival_ring_t *ring;
 
 void clearResources(int);
-process_t *CreateProcesses(const char *fileName, int *numberOfProcesses);
 char *myItoa(int number);
 
-process_t *processes = NULL;
-int semSchedGen;
+struct TraceReader *trace = NULL;
 
 int main(int argc, char *argv[])
 {
 
         int numberOfProcesses;
-        int schedOption;
+        char schedOption[POLICY_SPEC_SIZE];
         int quantum;
         int curTime = -1;
-        union Semun semun;
         pid_t schedPid;
+        // -v runs the clock in virtual time, -c N schedules on N CPUs,
+        // -w N holds arrivals back while N processes wait in the run queues,
+        // -p N forks N workers for the processes before the first one starts
+        char *clkMode = NULL;
+        char *cpus = "1";
+        char *highWater = "0";
+        char *poolSize = myItoa(WORKER_POOL_DEFAULT);
+        int opt;
+        while ((opt = getopt(argc, argv, "vc:w:p:")) != -1)
+        {
+                if (opt == 'v')
+                        clkMode = "-v";
+                else if (opt == 'c' && atoi(optarg) >= 1 && atoi(optarg) <= CLK_MAX_WORKERS)
+                        cpus = optarg;
+                else if (opt == 'w' && atoi(optarg) >= 0)
+                        highWater = optarg;
+                else if (opt == 'p' && atoi(optarg) >= 0)
+                        poolSize = optarg;
+                else
+                {
+                        fprintf(stderr, "usage: %s [-v] [-c cpus] [-w high-water mark] [-p workers] [trace], at most %d cpus\n", argv[0], CLK_MAX_WORKERS);
+                        exit(EXIT_FAILURE);
+                }
+        }
 
         signal(SIGINT, clearResources);
 
         // TODO Initialization
         // 1. Read the input files.
-        processes = CreateProcesses("processes.txt", &numberOfProcesses);
+        // the processes are taken in arrival order, a tick only looks at the ones it sends.
+        // The trace is text or binary, see trace_convert.c
+        trace = OpenTrace(optind < argc ? argv[optind] : "processes.txt", atoi(cpus));
+        numberOfProcesses = trace->count;
 
         // 2. Ask the user for the chosen scheduling algorithm and its parameters, if there are any.
-        printf("please enter the scheduling algorithm:\n");
-        printf("0: shortest remaining time next (SRTN)\n");
-        printf("1: Round robin (RR)\n");
-        printf("2: Non-preemptive Highest Priority First (NHPF)\n");
-
-        if ((schedOption = fgetc(stdin)) == EOF)
-        {
-                fprintf(stderr, "processe generator: error when reading sched option\n");
-                exit(EXIT_FAILURE);
-        }
-        fgetc(stdin); // take the newline out of the stdin
-
-        schedOption -= '0';
-
-        if (schedOption == 1)
-        {
-                printf("processe generator: please enter the quantum\n");
-
-                char value[100];
-                if (fgets(value, 100, stdin) == NULL)
-                {
-                        fprintf(stderr, "processe generator: error when reading quantum option\n");
-                        exit(EXIT_FAILURE);
-                }
-
-                quantum = atoi(value);
-        }
+        ReadPolicy("processe generator", schedOption, &quantum);
 
         // 3. Initiate and create the scheduler and clock processes.
-        msgqid = msgget(MSGQKEY, 0644 | IPC_CREAT);
-        if (msgqid == -1)
-        {
-                perror("processe generator: Failed to get the message queue\n");
-                exit(EXIT_FAILURE);
-        }
-
-        semSchedGen = semget(SEM_SCHED_GEN_KEY, 1, 0666 | IPC_CREAT);
-        if (semSchedGen == -1)
-        {
-                perror("Error in create sem");
-                exit(-1);
-        }
+        // the ring may be left by an interrupted run
+        ring = attachArrivalRing(1, &ringShm);
+        memset(ring, 0, sizeof(arrival_ring_t));
 
-        semun.val = 0; /* initial value of the semaphore, Binary semaphore */
-        if (semctl(semSchedGen, 0, SETVAL, semun) == -1)
+        // the clock writes every tick to it and the scheduler polls it, both inherit it
+        int tickFd = eventfd(0, 0);
+        if (tickFd == -1)
         {
-                perror("Error in semctl");
-                exit(-1);
+                perror("processe generator: Failed to create the tick eventfd\n");
+                exit(EXIT_FAILURE);
         }
+        char *tickFdArg = myItoa(tickFd);
 
         //for the clock
         if (fork() == 0)
         {
-                free(processes);
-
-                if (execl("build/clk.out", "clk.out", NULL) == -1)
+                if (execl("build/clk.out", "clk.out", "-e", tickFdArg, clkMode, NULL) == -1)
                 {
                         perror("process_generator: couldn't run clk.out\n");
                         exit(EXIT_FAILURE);
@@ -109,18 +98,23 @@ int main(int argc, char *argv[])
         }
 
         initClk();
+        // no limit until the scheduler published its first tick
+        clkShm->arrivalRoom = INT_MAX;
+
+        // the scheduler joins before it starts so the virtual clock can't leave it behind
+        clkJoin(CLK_GEN);
+        clkJoin(CLK_SCHED);
 
         //fork the scheduler
         if ((schedPid = fork()) == 0)
         {
-                free(processes);
-
-                if (execl("build/scheduler.out", "scheduler.out", myItoa(schedOption), myItoa(numberOfProcesses), myItoa(quantum), NULL) == -1)
+                if (execl("build/scheduler.out", "scheduler.out", schedOption, myItoa(numberOfProcesses), myItoa(quantum), cpus, highWater, poolSize, tickFdArg, NULL) == -1)
                 {
                         perror("process_generator: couldn't run scheduler.out\n");
                         exit(EXIT_FAILURE);
                 }
         }
+        close(tickFd);
 
         // 4. Use this function: getClk() after creating the clock process to initialize clock
         //attach to the clock
@@ -131,46 +125,46 @@ int main(int argc, char *argv[])
         while (1)
         {
 
-                if (getClk() == curTime)
+                int now = waitClk(curTime);
+                if (now == curTime)
                         continue;
 
-                curTime = getClk();
+                curTime = now;
 
                 // 6. Send the information to the scheduler at the appropriate time.
-                uint8_t exitFlag = 1;
-                for (int i = 0; i < numberOfProcesses; i++)
+                // Only as many as the scheduler has room for under its high-water mark,
+                // the other due processes are held back and tried again at the next tick.
+                // They're written to the ring and published together at the end.
+                int room = __atomic_load_n(&clkShm->arrivalRoom, __ATOMIC_ACQUIRE);
+                int ringFree = arrivalRingFree(ring), staged = 0, full = 0;
+                const process_t *proc;
+                while ((proc = PeekProcess(trace)) != NULL && proc->arrivalTime <= curTime)
                 {
-                        if (processes[i].arrived == 0)
+                        // the scheduler drains the ring once we're done with the
+                        // tick, so waiting for room would never end
+                        if (room == 0 || staged == ringFree)
                         {
-
-                                exitFlag = 0;
-
-                                if (processes[i].arrivalTime <= curTime)
-                                {
-                                        processes[i].arrived = 1;
-
-                                        struct msgbuff message;
-                                        message.mtype = 1;
-                                        message.proc = processes[i];
-
-                                        if (msgsnd(msgqid, &message, sizeof(process_t), 0) == -1)
-                                        {
-                                                printf("process_generator: problem in sending to msg queue\n");
-                                                exit(EXIT_FAILURE);
-                                        }
-                                }
+                                if (room != 0)
+                                        full = 1;
+                                break;
                         }
+
+                        *arrivalSlot(ring, ring->head + staged++) = *proc;
+                        SkipProcess(trace);
+                        room--;
                 }
+                arrivalRingPublish(ring, staged);
+                ring->fullTicks += full;
 
-                //notify the scheduler to work
-                if (exitFlag == 1)
+                //notify the scheduler to work, once we leave it doesn't wait for us anymore
+                if (proc == NULL)
                 {
-                        kill(schedPid, SIGMSGQ);
-                        up(semSchedGen);
+                        clkLeave(CLK_GEN);
                         break;
                 }
 
-                up(semSchedGen);
+                // the held back processes are overdue, they're tried again at the next tick
+                clkDone(CLK_GEN, proc->arrivalTime > curTime ? proc->arrivalTime : curTime + 1);
         }
 
         int status;
@@ -186,94 +180,13 @@ int main(int argc, char *argv[])
 void clearResources(int signum)
 {
         //TODO Clears all resources in case of interruption
-        free(processes);
-        msgctl(msgqid, IPC_RMID, (struct msqid_ds *)NULL);
-        semctl(semSchedGen, 1, IPC_RMID);
+        CloseTrace(trace);
+        shmdt(ring);
+        shmctl(ringShm, IPC_RMID, (struct shmid_ds *)NULL);
 
         exit(EXIT_SUCCESS);
 }
 
-/**
- * @brief Create a Processes objects array after parsing the processes file.
- * 
- * @param fileName the name of the processes file
- * @param numberOfProcesses the number of processes in the array.
- * @return process* array of processes
- */
-process_t *CreateProcesses(const char *fileName, int *numberOfProcesses)
-{
-        char *number = NULL;
-        int numberSize = 0;
-
-        char *line = NULL;
-        size_t len = 0;
-        ssize_t lineLength;
-
-        FILE *fp;
-
-        size_t processesNo = 0;
-        process_t *processes = NULL;
-
-        fp = fopen(fileName, "r");
-
-        if (fp == NULL)
-        {
-                perror("processe generator: Error while opening the file.\n");
-                exit(EXIT_FAILURE);
-        }
-
-        while ((lineLength = getline(&line, &len, fp)) != -1)
-        {
-                int chIndex = 0;
-                if (line[chIndex] == '#')
-                        continue;
-
-                int numbers[5];
-                for (int member = 0; member < 5; member++)
-                {
-                        while (line[chIndex] != '\t' && line[chIndex] != '\n')
-                        {
-                                numberSize++;
-                                number = (char *)realloc(number, numberSize);
-                                number[numberSize - 1] = line[chIndex];
-
-                                chIndex++;
-                        }
-                        chIndex++;
-
-                        //null terminate the string passed to atoi
-                        numberSize++;
-                        number = (char *)realloc(number, numberSize);
-                        number[numberSize - 1] = '\0';
-
-#ifdef DEBUG
-                        printf("%d\t", atoi(number));
-#endif
-                        numbers[member] = atoi(number);
-                        numberSize = 0;
-                        free(number);
-                        number = NULL;
-                }
-#ifdef DEBUG
-                printf("\n");
-#endif
-                processesNo++;
-                processes = (process_t *)realloc(processes, sizeof(process_t) * processesNo);
-                processes[processesNo - 1].id = numbers[0];
-                processes[processesNo - 1].arrivalTime = numbers[1];
-                processes[processesNo - 1].runTime = numbers[2];
-                processes[processesNo - 1].priority = numbers[3];
-                processes[processesNo - 1].arrived = 0;
-                processes[processesNo - 1].memSize =  numbers[4];
-        }
-        free(line);
-
-        fclose(fp);
-
-        *numberOfProcesses = processesNo;
-        return processes;
-}
-
 /**
  * @brief convert an integer to a null terminated string.
  * 
@@ -282,31 +195,8 @@ process_t *CreateProcesses(const char *fileName, int *numberOfProcesses)
  */
 char *myItoa(int number)
 {
-        uint8_t ch;
-        int numberSize = 0;
-        char *numberStr = NULL;
-        if (number != 0)
-        {
-                while ((ch = number % 10))
-                {
-                        number /= 10;
-
-                        numberSize++;
-                        numberStr = (char *)realloc(numberStr, numberSize);
-                        numberStr[numberSize - 1] = ch + '0';
-                }
-        }
-        else
-        {
-                numberSize++;
-                numberStr = (char *)realloc(numberStr, numberSize);
-                numberStr[numberSize - 1] = '0';
-        }
-
-        //null terminate the string
-        numberSize++;
-        numberStr = (char *)realloc(numberStr, numberSize);
-        numberStr[numberSize - 1] = '\0';
+        char *numberStr = (char *)malloc(12);
+        snprintf(numberStr, 12, "%d", number);
 
         return numberStr;
-}
\ No newline at end of file
+}
@@ -22,6 +22,9 @@ typedef struct process
 	int priority;	 /**< The priority of the process */
 	uint8_t arrived; /**< flag to track if the process arrived or not */
 	int memSize;
+	int deadline;	 /**< The deadline relative to the arrival, 0 if it has none */
+	int period;		 /**< The period of a periodic task, 0 if it runs once */
+	int task;		 /**< The id of the periodic task the job was released by, its own id otherwise */
 } process_t;
 
 #endif /* _PROCESS_GENERATOR_H */
@@ -0,0 +1,287 @@
+/**
+ * @file rb_tree.c
+ * @brief An intrusive red-black tree with a cached leftmost node.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#include "rb_tree.h"
+
+void RBInit(rb_tree *tree)
+{
+        tree->root = NULL;
+        tree->leftmost = NULL;
+        tree->size = 0;
+}
+
+/**
+ * @brief Put new in the place of old under old's parent
+ */
+void RBReplaceChild(rb_tree *tree, rb_node *old, rb_node *new)
+{
+        if (old->parent == NULL)
+                tree->root = new;
+        else if (old == old->parent->left)
+                old->parent->left = new;
+        else
+                old->parent->right = new;
+        if (new != NULL)
+                new->parent = old->parent;
+}
+
+void RBRotateLeft(rb_tree *tree, rb_node *x)
+{
+        rb_node *y = x->right;
+
+        x->right = y->left;
+        if (y->left != NULL)
+                y->left->parent = x;
+        RBReplaceChild(tree, x, y);
+        y->left = x;
+        x->parent = y;
+}
+
+void RBRotateRight(rb_tree *tree, rb_node *x)
+{
+        rb_node *y = x->left;
+
+        x->left = y->right;
+        if (y->right != NULL)
+                y->right->parent = x;
+        RBReplaceChild(tree, x, y);
+        y->right = x;
+        x->parent = y;
+}
+
+/**
+ * @brief Insert a node after the ones with the same key
+ *
+ * @param tree the tree
+ * @param node the node, its key has to be set
+ * @return int the depth the node was inserted at, the root is at 0
+ */
+int RBInsert(rb_tree *tree, rb_node *node)
+{
+        rb_node **link = &tree->root, *parent = NULL;
+        int leftmost = 1, depth = 0;
+
+        while (*link != NULL)
+        {
+                parent = *link;
+                depth++;
+                if (node->key < parent->key)
+                {
+                        link = &parent->left;
+                }
+                else
+                {
+                        link = &parent->right;
+                        leftmost = 0;
+                }
+        }
+
+        node->parent = parent;
+        node->left = node->right = NULL;
+        node->red = 1;
+        *link = node;
+        if (leftmost)
+                tree->leftmost = node;
+        tree->size++;
+
+        // a red node can't have a red parent
+        while (node->parent != NULL && node->parent->red)
+        {
+                parent = node->parent;
+                rb_node *grand = parent->parent;
+
+                if (parent == grand->left)
+                {
+                        rb_node *uncle = grand->right;
+                        if (uncle != NULL && uncle->red)
+                        {
+                                parent->red = uncle->red = 0;
+                                grand->red = 1;
+                                node = grand;
+                                continue;
+                        }
+                        if (node == parent->right)
+                        {
+                                RBRotateLeft(tree, parent);
+                                parent = node;
+                        }
+                        parent->red = 0;
+                        grand->red = 1;
+                        RBRotateRight(tree, grand);
+                        break;
+                }
+                else
+                {
+                        rb_node *uncle = grand->left;
+                        if (uncle != NULL && uncle->red)
+                        {
+                                parent->red = uncle->red = 0;
+                                grand->red = 1;
+                                node = grand;
+                                continue;
+                        }
+                        if (node == parent->left)
+                        {
+                                RBRotateRight(tree, parent);
+                                parent = node;
+                        }
+                        parent->red = 0;
+                        grand->red = 1;
+                        RBRotateLeft(tree, grand);
+                        break;
+                }
+        }
+        tree->root->red = 0;
+
+        return depth;
+}
+
+/**
+ * @brief The node that comes after the given one, NULL if it's the last
+ */
+rb_node *RBNext(rb_node *node)
+{
+        if (node->right != NULL)
+        {
+                node = node->right;
+                while (node->left != NULL)
+                        node = node->left;
+                return node;
+        }
+
+        while (node->parent != NULL && node == node->parent->right)
+                node = node->parent;
+        return node->parent;
+}
+
+/**
+ * @brief Restore the black heights after a black node was taken out above x
+ *
+ * @param x the node that took its place, may be NULL
+ * @param parent the parent of x
+ */
+void RBEraseFixup(rb_tree *tree, rb_node *x, rb_node *parent)
+{
+        while (x != tree->root && (x == NULL || !x->red))
+        {
+                if (x == parent->left)
+                {
+                        rb_node *sibling = parent->right;
+                        if (sibling->red)
+                        {
+                                sibling->red = 0;
+                                parent->red = 1;
+                                RBRotateLeft(tree, parent);
+                                sibling = parent->right;
+                        }
+                        if ((sibling->left == NULL || !sibling->left->red) &&
+                            (sibling->right == NULL || !sibling->right->red))
+                        {
+                                sibling->red = 1;
+                                x = parent;
+                                parent = x->parent;
+                                continue;
+                        }
+                        if (sibling->right == NULL || !sibling->right->red)
+                        {
+                                sibling->left->red = 0;
+                                sibling->red = 1;
+                                RBRotateRight(tree, sibling);
+                                sibling = parent->right;
+                        }
+                        sibling->red = parent->red;
+                        parent->red = 0;
+                        sibling->right->red = 0;
+                        RBRotateLeft(tree, parent);
+                }
+                else
+                {
+                        rb_node *sibling = parent->left;
+                        if (sibling->red)
+                        {
+                                sibling->red = 0;
+                                parent->red = 1;
+                                RBRotateRight(tree, parent);
+                                sibling = parent->left;
+                        }
+                        if ((sibling->left == NULL || !sibling->left->red) &&
+                            (sibling->right == NULL || !sibling->right->red))
+                        {
+                                sibling->red = 1;
+                                x = parent;
+                                parent = x->parent;
+                                continue;
+                        }
+                        if (sibling->left == NULL || !sibling->left->red)
+                        {
+                                sibling->right->red = 0;
+                                sibling->red = 1;
+                                RBRotateLeft(tree, sibling);
+                                sibling = parent->left;
+                        }
+                        sibling->red = parent->red;
+                        parent->red = 0;
+                        sibling->left->red = 0;
+                        RBRotateRight(tree, parent);
+                }
+                x = tree->root;
+        }
+
+        if (x != NULL)
+                x->red = 0;
+}
+
+/**
+ * @brief Take a node out of the tree
+ *
+ * @param tree the tree
+ * @param node a node that is in the tree
+ */
+void RBErase(rb_tree *tree, rb_node *node)
+{
+        rb_node *x, *parent;
+        int removedRed = node->red;
+
+        if (tree->leftmost == node)
+                tree->leftmost = RBNext(node);
+        tree->size--;
+
+        if (node->left == NULL || node->right == NULL)
+        {
+                x = node->left != NULL ? node->left : node->right;
+                parent = node->parent;
+                RBReplaceChild(tree, node, x);
+        }
+        else
+        {
+                // the successor takes the place and the color of the node
+                rb_node *next = node->right;
+                while (next->left != NULL)
+                        next = next->left;
+                removedRed = next->red;
+                x = next->right;
+
+                if (next->parent == node)
+                {
+                        parent = next;
+                }
+                else
+                {
+                        parent = next->parent;
+                        RBReplaceChild(tree, next, x);
+                        next->right = node->right;
+                        next->right->parent = next;
+                }
+                RBReplaceChild(tree, node, next);
+                next->left = node->left;
+                next->left->parent = next;
+                next->red = node->red;
+        }
+
+        if (!removedRed)
+                RBEraseFixup(tree, x, parent);
+}
@@ -0,0 +1,43 @@
+/**
+ * @file rb_tree.h
+ * @brief An intrusive red-black tree. The nodes live inside the structures
+ * they order, so inserting and erasing never allocate, and the leftmost node
+ * is cached so the minimum is O(1) while inserting and erasing are O(log n).
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#ifndef _RB_TREE_H
+#define _RB_TREE_H
+
+#include <stddef.h>
+
+/**
+ * @brief A node of the tree, embedded in the structure it orders.
+ * Nodes with equal keys keep their insertion order.
+ */
+typedef struct rb_node
+{
+        struct rb_node *parent;
+        struct rb_node *left;
+        struct rb_node *right;
+        int red;
+        long key; /**< what the tree is ordered by */
+} rb_node;
+
+typedef struct
+{
+        rb_node *root;
+        rb_node *leftmost; /**< the node with the smallest key, NULL if the tree is empty */
+        int size;
+} rb_tree;
+
+/** the structure of the given type the node is the member of */
+#define RB_ENTRY(ptr, type, member) ((type *)((char *)(ptr) - offsetof(type, member)))
+
+void RBInit(rb_tree *tree);
+int RBInsert(rb_tree *tree, rb_node *node);
+void RBErase(rb_tree *tree, rb_node *node);
+rb_node *RBNext(rb_node *node);
+
+#endif /* _RB_TREE_H */
@@ -15,10 +15,11 @@ struct Queue* CreateQueue(unsigned capacity)
 { 
         struct Queue* queue = (struct Queue*)malloc( 
         sizeof(struct Queue)); 
-        queue->capacity = capacity; 
+        queue->capacity = capacity > 0 ? capacity : 1; 
+        queue->chunk = queue->capacity; 
         queue->front = queue->size = 0; 
 
-        queue->rear = capacity - 1; 
+        queue->rear = queue->capacity - 1; 
         queue->array = malloc(queue->capacity * sizeof(PCB*)); 
         return queue; 
 } 
@@ -33,9 +34,33 @@ int IsEmpty(struct Queue* queue)
         return (queue->size == 0); 
 } 
 
+/**
+ * @brief Make room for another chunk of PCBs. The ring is copied from its
+ * front, so the new slots come after the rear.
+ */
+static void Grow(struct Queue* queue) 
+{ 
+        unsigned capacity = queue->capacity + queue->chunk; 
+        PCB** array = malloc(capacity * sizeof(PCB*)); 
+        if (array == NULL) 
+        { 
+                perror("ready queue: can't grow the queue"); 
+                exit(EXIT_FAILURE); 
+        } 
+
+        for (int i = 0; i < queue->size; i++) 
+                array[i] = queue->array[(queue->front + i) % queue->capacity]; 
+
+        free(queue->array); 
+        queue->array = array; 
+        queue->capacity = capacity; 
+        queue->front = 0; 
+        queue->rear = queue->size - 1; 
+} 
+
 void Enqueue(struct Queue* queue, PCB* item) 
 { 
-        if (IsFull(queue)) return; 
+        if (IsFull(queue)) Grow(queue); 
         queue->rear = (queue->rear + 1) % queue->capacity; 
         queue->array[queue->rear] = item; 
         queue->size = queue->size + 1; 
@@ -14,9 +14,14 @@
 struct Queue { 
         int front, rear, size; 
         unsigned capacity; 
+        unsigned chunk;    /**< the slots added whenever a full queue gets a PCB */
         PCB** array; 
 }; 
 
+/**
+ * @brief A FIFO of PCBs, it starts with room for capacity of them and grows
+ * by as many whenever it's full
+ */
 struct Queue* CreateQueue(unsigned capacity);
 int IsFull(struct Queue* queue);
 int IsEmpty(struct Queue* queue);
@@ -0,0 +1,727 @@
+/**
+ * @file sched_engine.c
+ * @brief The scheduling policies, their bookkeeping and the output files,
+ * independent of how the scheduled processes are run. The scheduler drives it
+ * with real processes and the clock, the simulator drives it on its own.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <limits.h>
+#include <unistd.h>
+#include "sched_engine.h"
+#include "pcb_pool.h"
+#include "event_log.h"
+#include "stats.h"
+#include "stats_page.h"
+
+PCB *running[MAX_CPUS];
+policy_t *policy[MAX_CPUS];
+int ncpu;
+
+FILE *outputFile;
+
+const dispatcher_t *dispatcher;
+
+int nproc;
+int dropped = 0;
+
+// the finished processes, their means and the histograms of every priority class
+#define PRIORITY_CLASSES 16 // the priorities from 15 on share the last class
+enum
+{
+        STAT_WAITING,
+        STAT_RESPONSE,
+        STAT_TA,
+        STAT_WTA, // in hundredths
+        STATS
+};
+const char *statNames[STATS] = {"waiting", "response", "TA", "WTA"};
+welford_t wtaStats, waitingStats;
+histogram_t *latency[PRIORITY_CLASSES + 1][STATS]; // the last class is all of them, allocated when it gets its first process
+
+// state at the end of the previous tick, the clock may skip ticks in between
+int totalTime = 0, idleTime[MAX_CPUS];
+int prevTime = -1, prevIdle[MAX_CPUS];
+int steals[MAX_CPUS];
+int loggedReady[MAX_CPUS]; // the depths of the run queues the event log has
+long switches[MAX_CPUS];
+
+// the counters schedtop.out shows while the engine runs
+stats_page_t *statsPage = NULL;
+int statsShm;
+int memoryUsed = 0, memoryChanged = 1;
+
+// arrivals are held back once this many PCBs wait in the run queues, 0 never holds them
+int highWater = 0, maxWaiting = 0;
+
+// the jobs with a deadline, lateness is the finish time minus the deadline
+#define LATENESS_BUCKETS 16
+int deadlineJobs = 0, deadlineMisses = 0, maxLateness = INT_MIN;
+long totalLateness = 0;
+int latenessBuckets[LATENESS_BUCKETS];
+
+void ScheduleCPU(int cpu, int curTime);
+int Steal(int cpu, int curTime);
+void StartEntry(PCB *entry, int curTime);
+void ResumeEntry(PCB *entry, int curTime);
+void StopEntry(PCB *entry, int curTime);
+void PublishStats(int curTime);
+
+/**
+ * @brief Create the output files and the policy
+ *
+ * @param spec the policy name or number and its options, see CreatePolicy()
+ * @param numberOfProcesses the number of processes that will arrive
+ * @param quantum the quantum the user entered
+ * @param cpus the number of CPUs, every one gets its own run queue
+ * @param disp how to run the processes
+ */
+void InitScheduler(const char *spec, int numberOfProcesses, int quantum, int cpus, const dispatcher_t *disp)
+{
+        if (cpus < 1 || cpus > MAX_CPUS)
+        {
+                fprintf(stderr, "Scheduler: the number of CPUs has to be from 1 to %d\n", MAX_CPUS);
+                exit(EXIT_FAILURE);
+        }
+        ncpu = cpus;
+
+        for (int cpu = 0; cpu < ncpu; cpu++)
+        {
+                policy[cpu] = CreatePolicy(spec, quantum);
+                if (policy[cpu] == NULL)
+                {
+                        fprintf(stderr, "Scheduler: unknown scheduling algorithm or bad options %s\n", spec);
+                        exit(EXIT_FAILURE);
+                }
+                running[cpu] = NULL;
+                idleTime[cpu] = 0;
+                prevIdle[cpu] = 0;
+                steals[cpu] = 0;
+                loggedReady[cpu] = 0;
+                switches[cpu] = 0;
+        }
+
+        // the logs are rendered from the events at the end
+        OpenEventLog("scheduler.events", ncpu);
+
+        //initialize variables
+        dispatcher = disp;
+
+        nproc = numberOfProcesses;
+
+        // a run without the stats page only can't be watched
+        statsPage = attachStatsPage(1, &statsShm);
+        if (statsPage != NULL)
+        {
+                statsWriteBegin(statsPage);
+                memset((char *)statsPage + sizeof(statsPage->seq), 0, sizeof(stats_page_t) - sizeof(statsPage->seq));
+                statsPage->pid = getpid();
+                statsPage->ncpu = ncpu;
+                statsPage->processes = numberOfProcesses;
+                statsPage->memorySize = MEM_MAX_SIZE;
+                for (int cpu = 0; cpu < ncpu; cpu++)
+                        statsPage->running[cpu] = -1;
+                statsWriteEnd(statsPage);
+                // a run that exits on an error doesn't leave it behind
+                atexit(RemoveStatsPage);
+        }
+}
+
+/**
+ * @brief Set the high-water mark of the run queues, see ArrivalRoom()
+ *
+ * @param mark the number of waiting PCBs, 0 to never hold arrivals back
+ */
+void SetHighWater(int mark)
+{
+        highWater = mark > 0 ? mark : 0;
+}
+
+/**
+ * @brief The PCBs waiting in all the run queues
+ */
+int Waiting()
+{
+        int waiting = 0;
+        for (int cpu = 0; cpu < ncpu; cpu++)
+                waiting += policy[cpu]->nready;
+        return waiting;
+}
+
+/**
+ * @brief The arrivals the run queues take at the next tick before they reach
+ * the high-water mark. The driver holds the others back and tries them again
+ * at the tick after, they keep their arrival time so the ticks they were held
+ * count as waiting.
+ *
+ * @return int INT_MAX if there's no high-water mark
+ */
+int ArrivalRoom()
+{
+        if (highWater == 0)
+                return INT_MAX;
+        return Waiting() < highWater ? highWater - Waiting() : 0;
+}
+
+/**
+ * @brief Account a job with a deadline. Lateness is bucketed as on time, 1,
+ * 2-3, 4-7 and so on, the last bucket takes everything later.
+ *
+ * @param lateness the finish time minus the deadline
+ */
+void DeadlineFinished(int lateness)
+{
+        deadlineJobs++;
+        totalLateness += lateness;
+        if (lateness > maxLateness)
+                maxLateness = lateness;
+        if (lateness <= 0)
+        {
+                latenessBuckets[0]++;
+                return;
+        }
+
+        deadlineMisses++;
+        int bucket = 1;
+        while (lateness > 1 && bucket < LATENESS_BUCKETS - 1)
+        {
+                lateness >>= 1;
+                bucket++;
+        }
+        latenessBuckets[bucket]++;
+}
+
+/**
+ * @brief Write the deadline misses and the lateness distribution, if the trace has deadlines
+ */
+void ReportDeadlines(FILE *perf)
+{
+        if (deadlineJobs == 0)
+                return;
+
+        fprintf(perf, "deadline misses = %d of %d (%g %%)\n", deadlineMisses, deadlineJobs,
+                round(deadlineMisses * 10000.0 / deadlineJobs) / 100.0);
+        fprintf(perf, "avg lateness = %g, max lateness = %d\n",
+                round(totalLateness * 100.0 / deadlineJobs) / 100.0, maxLateness);
+        fprintf(perf, "lateness <= 0: %d\n", latenessBuckets[0]);
+        for (int bucket = 1; bucket < LATENESS_BUCKETS; bucket++)
+        {
+                int low = 1 << (bucket - 1), high = (1 << bucket) - 1;
+                if (latenessBuckets[bucket] == 0)
+                        continue;
+                if (bucket == LATENESS_BUCKETS - 1)
+                        fprintf(perf, "lateness >= %d: %d\n", low, latenessBuckets[bucket]);
+                else if (low == high)
+                        fprintf(perf, "lateness %d: %d\n", low, latenessBuckets[bucket]);
+                else
+                        fprintf(perf, "lateness %d-%d: %d\n", low, high, latenessBuckets[bucket]);
+        }
+}
+
+/**
+ * @brief Add a histogram of every statistic for a priority class
+ */
+void AddPriorityClass(int class)
+{
+        for (int stat = 0; stat < STATS; stat++)
+        {
+                latency[class][stat] = (histogram_t *)calloc(1, sizeof(histogram_t));
+                if (latency[class][stat] == NULL)
+                {
+                        perror("Schedular: Can not allocate the statistics\n");
+                        exit(EXIT_FAILURE);
+                }
+        }
+}
+
+/**
+ * @brief Account the waiting, response and turnaround times of a finished
+ * PCB for all the processes and for its priority class
+ */
+void AccountLatency(PCB *pcb, int ta, float wta)
+{
+        int class = pcb->priority < 0 ? 0 : pcb->priority < PRIORITY_CLASSES ? pcb->priority : PRIORITY_CLASSES - 1;
+        double hundredths = round(wta * 100.0);
+        int values[STATS] = {pcb->waitingTime, pcb->responseTime, ta, hundredths < INT_MAX ? (int)hundredths : INT_MAX};
+
+        WelfordAdd(&wtaStats, wta);
+        WelfordAdd(&waitingStats, pcb->waitingTime);
+
+        if (latency[class][0] == NULL)
+                AddPriorityClass(class);
+        if (latency[PRIORITY_CLASSES][0] == NULL)
+                AddPriorityClass(PRIORITY_CLASSES);
+        for (int stat = 0; stat < STATS; stat++)
+        {
+                HistogramAdd(latency[class][stat], values[stat]);
+                HistogramAdd(latency[PRIORITY_CLASSES][stat], values[stat]);
+        }
+}
+
+/**
+ * @brief A running PCB is finished. Free its memory and account its statistics.
+ *
+ * @param pcb the PCB, it ran on pcb->cpu
+ * @param curTime the current tick
+ */
+void ProcFinished(PCB *pcb, int curTime)
+{
+        int cpu = pcb->cpu;
+        int ta = curTime - pcb->arrivalTime;
+        float wta = ((float)ta) / pcb->runTime;
+
+        AccountLatency(pcb, ta, wta);
+        if (pcb->deadline > 0)
+                DeadlineFinished(curTime - pcb->deadline);
+
+        policy[cpu]->on_finish(policy[cpu], pcb, curTime);
+
+        LogMemoryEvent(EVENT_FREED, curTime, pcb);
+        memoryUsed -= pcb->memoryNode->data;
+        memoryChanged = 1;
+        Deallocate(pcb->memoryNode);
+
+        LogStateEvent(EVENT_FINISHED, curTime, pcb, ta, wta);
+
+        FreePCB(pcb);
+        running[cpu] = NULL;
+        nproc--;
+}
+
+/**
+ * @brief The CPU with the fewest PCBs, waiting or running
+ */
+int LeastLoadedCPU()
+{
+        int best = 0, bestLoad = INT_MAX;
+        for (int cpu = 0; cpu < ncpu; cpu++)
+        {
+                int load = policy[cpu]->nready + (running[cpu] != NULL);
+                if (load < bestLoad)
+                {
+                        best = cpu;
+                        bestLoad = load;
+                }
+        }
+        return best;
+}
+
+/**
+ * @brief Create a PCB object and insert it in the ready queue of the least loaded CPU
+ *
+ * @param proc process object
+ * @param curTime the current tick
+ */
+void CreateEntry(process_t proc, int curTime)
+{
+        // the policies' own fields start zeroed
+        PCB *entry = AllocPCB(proc.id);
+        entry->arrivalTime = proc.arrivalTime;
+        entry->runTime = proc.runTime;
+        entry->priority = proc.priority;
+        entry->state = READY;
+        entry->remainingTime = proc.runTime;
+        entry->waitingTime = 0;
+        entry->deadline = proc.deadline > 0 ? proc.arrivalTime + proc.deadline : 0;
+        entry->memoryNode = Allocate(proc.memSize);
+        if (entry->memoryNode == NULL)
+        {
+                LogArrivalEvent(EVENT_DROPPED, curTime, entry, proc.memSize);
+                FreePCB(entry);
+                nproc--;
+                dropped++;
+        }
+        else
+        {
+                entry->cpu = LeastLoadedCPU();
+                policy[entry->cpu]->on_arrival(policy[entry->cpu], entry, curTime);
+                policy[entry->cpu]->nready++;
+
+                LogArrivalEvent(EVENT_ARRIVED, curTime, entry, proc.memSize);
+                LogMemoryEvent(EVENT_ALLOCATED, curTime, entry);
+                memoryUsed += entry->memoryNode->data;
+                memoryChanged = 1;
+        }
+}
+
+/**
+ * @brief Run the policies for the current tick. The driver has already brought
+ * the remaining times of the running PCBs up to date, finished the ones that
+ * are done and created the arrivals of the tick.
+ *
+ * @param curTime the current tick
+ */
+void Schedule(int curTime)
+{
+        totalTime += prevTime == -1 ? 1 : curTime - prevTime;
+
+        for (int cpu = 0; cpu < ncpu; cpu++)
+        {
+                if (prevIdle[cpu])
+                        idleTime[cpu] += curTime - prevTime - 1;
+                ScheduleCPU(cpu, curTime);
+        }
+
+        // a CPU is only idle if its own run queue is empty, then it takes work from the others
+        for (int cpu = 0; cpu < ncpu && ncpu > 1; cpu++)
+        {
+                if (running[cpu] == NULL && !Steal(cpu, curTime))
+                        break;
+        }
+
+        for (int cpu = 0; cpu < ncpu; cpu++)
+        {
+                if (running[cpu] == NULL)
+                {
+                        idleTime[cpu]++;
+#ifdef DEBUG
+                        printf("current time is %d and idle time of cpu %d is %d\n", curTime, cpu, idleTime[cpu]);
+#endif
+                }
+                prevIdle[cpu] = running[cpu] == NULL;
+
+                if (policy[cpu]->nready != loggedReady[cpu])
+                {
+                        loggedReady[cpu] = policy[cpu]->nready;
+                        LogReadyEvent(curTime, cpu, loggedReady[cpu]);
+                }
+        }
+
+        if (Waiting() > maxWaiting)
+                maxWaiting = Waiting();
+        prevTime = curTime;
+        PublishStats(curTime);
+}
+
+/**
+ * @brief Publish the counters of the tick to the stats page. The largest free
+ * block is only looked for when the memory changed.
+ *
+ * @param curTime the current tick
+ */
+void PublishStats(int curTime)
+{
+        long total = 0;
+
+        if (statsPage == NULL)
+                return;
+
+        statsWriteBegin(statsPage);
+        statsPage->tick = curTime;
+        statsPage->finished = wtaStats.n;
+        statsPage->dropped = dropped;
+        statsPage->ready = Waiting();
+        for (int cpu = 0; cpu < ncpu; cpu++)
+        {
+                statsPage->running[cpu] = running[cpu] != NULL ? running[cpu]->id : -1;
+                statsPage->cpuReady[cpu] = policy[cpu]->nready;
+                statsPage->idle[cpu] = idleTime[cpu];
+                statsPage->cpuSwitches[cpu] = switches[cpu];
+                total += switches[cpu];
+        }
+        statsPage->switches = total;
+        statsPage->memoryUsed = memoryUsed;
+        if (memoryChanged)
+        {
+                statsPage->largestFree = LargestFreeBlock();
+                memoryChanged = 0;
+        }
+        statsWriteEnd(statsPage);
+}
+
+/**
+ * @brief Mark the run as over on the stats page and remove it, the readers
+ * that have it attached still see the last counters. It's also run at exit,
+ * a forked worker that exits before its exec leaves the page alone.
+ */
+void RemoveStatsPage()
+{
+        if (statsPage == NULL || statsPage->pid != getpid())
+                return;
+
+        statsWriteBegin(statsPage);
+        statsPage->done = 1;
+        statsWriteEnd(statsPage);
+        shmdt(statsPage);
+        shmctl(statsShm, IPC_RMID, NULL);
+        statsPage = NULL;
+}
+
+/**
+ * @brief Run the policy of a CPU on its running PCB and its own run queue
+ *
+ * @param cpu the CPU
+ * @param curTime the current tick
+ */
+void ScheduleCPU(int cpu, int curTime)
+{
+        policy_t *rq = policy[cpu];
+
+        if (running[cpu] != NULL && rq->on_tick(rq, running[cpu], curTime - prevTime, curTime) && rq->nready > 0)
+        {
+                StopEntry(running[cpu], curTime);
+                rq->on_preempt(rq, running[cpu], curTime);
+                rq->nready++;
+                running[cpu] = NULL;
+        }
+
+        if (running[cpu] == NULL && rq->nready > 0)
+        {
+                running[cpu] = rq->pick_next(rq, curTime);
+                rq->nready--;
+                running[cpu]->cpu = cpu;
+                if (running[cpu]->state == READY)
+                        StartEntry(running[cpu], curTime);
+                else if (running[cpu]->state == BLOCKED)
+                        ResumeEntry(running[cpu], curTime);
+        }
+}
+
+/**
+ * @brief Move a waiting PCB from the busiest run queue to an idle CPU and run it
+ *
+ * @param cpu the idle CPU, its run queue is empty
+ * @param curTime the current tick
+ * @return int 0 if no run queue has a PCB waiting
+ */
+int Steal(int cpu, int curTime)
+{
+        int victim = -1;
+        for (int other = 0; other < ncpu; other++)
+        {
+                if (policy[other]->nready > 0 && (victim == -1 || policy[other]->nready > policy[victim]->nready))
+                        victim = other;
+        }
+        if (victim == -1)
+                return 0;
+
+        PCB *pcb = policy[victim]->steal(policy[victim], curTime);
+        policy[victim]->nready--;
+        policy[cpu]->on_arrival(policy[cpu], pcb, curTime);
+        policy[cpu]->nready++;
+        steals[cpu]++;
+
+        ScheduleCPU(cpu, curTime);
+        return 1;
+}
+
+/**
+ * @brief Start the PCB for the first time
+ *
+ * @param curTime the current tick
+ */
+void StartEntry(PCB *entry, int curTime)
+{
+        // Setting initial waiting time
+        entry->waitingTime = curTime - entry->arrivalTime;
+        entry->responseTime = entry->waitingTime;
+
+        LogStateEvent(EVENT_STARTED, curTime, entry, 0, 0);
+        switches[entry->cpu]++;
+
+        // Start a new process. (Fork it and give it its parameters.)
+        SetPCBPid(entry, dispatcher->start(entry));
+}
+
+/**
+ * @brief Continue a PCB that was stopped
+ *
+ * @param curTime the current tick
+ */
+void ResumeEntry(PCB *entry, int curTime)
+{
+        dispatcher->resume(entry);
+        entry->state = READY;
+        entry->waitingTime += curTime - entry->waitStart;
+
+        LogStateEvent(EVENT_RESUMED, curTime, entry, 0, 0);
+        switches[entry->cpu]++;
+}
+
+/**
+ * @brief Stop the running PCB, the caller puts it back in the ready queue
+ *
+ * @param curTime the current tick
+ */
+void StopEntry(PCB *entry, int curTime)
+{
+        LogStateEvent(EVENT_STOPPED, curTime, entry, 0, 0);
+
+        entry->state = BLOCKED;
+        entry->waitStart = curTime;
+        dispatcher->stop(entry);
+}
+
+/**
+ * @brief Get the next tick the scheduler has something to do at on its own,
+ * i.e. a running process finishes or its quantum expires. Arrivals are
+ * the driver's business.
+ *
+ * @param curTime the current tick
+ * @return int the next tick, INT_MAX if there's nothing to wait for
+ */
+int NextEvent(int curTime)
+{
+        int next = INT_MAX;
+
+        for (int cpu = 0; cpu < ncpu; cpu++)
+        {
+                if (running[cpu])
+                {
+                        if (curTime + running[cpu]->remainingTime < next)
+                                next = curTime + running[cpu]->remainingTime;
+                        if (policy[cpu]->next_event != NULL)
+                        {
+                                int preempt = policy[cpu]->next_event(policy[cpu], running[cpu], curTime);
+                                if (preempt < next)
+                                        next = preempt;
+                        }
+                }
+                else if (policy[cpu]->nready > 0)
+                        next = curTime + 1;
+        }
+
+        return next;
+}
+
+/**
+ * @brief Write the percentiles of the statistics of all the processes and of
+ * every priority class that had one. The WTA is in the same hundredths it's
+ * logged in.
+ */
+void ReportLatency(FILE *fp)
+{
+        static const double quantiles[] = {0.5, 0.9, 0.99, 0.999};
+
+        if (dropped > 0)
+                fprintf(fp, "dropped = %d (no memory)\n", dropped);
+        if (latency[PRIORITY_CLASSES][0] == NULL)
+                return;
+
+        fprintf(fp, "%-9s %-8s %8s %9s %9s %9s %9s %9s\n", "latency", "priority", "jobs", "p50", "p90", "p99", "p99.9", "max");
+        for (int i = 0; i <= PRIORITY_CLASSES; i++)
+        {
+                // all the processes first
+                int class = (i + PRIORITY_CLASSES) % (PRIORITY_CLASSES + 1);
+                char name[16];
+
+                if (latency[class][0] == NULL)
+                        continue;
+                if (class == PRIORITY_CLASSES)
+                        snprintf(name, sizeof(name), "all");
+                else if (class == PRIORITY_CLASSES - 1)
+                        snprintf(name, sizeof(name), "%d+", class);
+                else
+                        snprintf(name, sizeof(name), "%d", class);
+
+                for (int stat = 0; stat < STATS; stat++)
+                {
+                        const histogram_t *h = latency[class][stat];
+                        double scale = stat == STAT_WTA ? 100.0 : 1.0;
+
+                        fprintf(fp, "%-9s %-8s %8ld", statNames[stat], name, h->count);
+                        for (int q = 0; q < (int)(sizeof(quantiles) / sizeof(quantiles[0])); q++)
+                                fprintf(fp, " %9g", HistogramPercentile(h, quantiles[q]) / scale);
+                        fprintf(fp, " %9g\n", h->max / scale);
+                }
+        }
+}
+
+/**
+ * @brief Drain the event log and render scheduler.log and memory.log from it
+ */
+void RenderLogs()
+{
+        CloseEventLog();
+
+        FILE *log = fopen("scheduler.log", "w");
+        FILE *memoryLog = fopen("memory.log", "w");
+        if (log == NULL)
+        {
+                perror("Schedular: Can not create output file\n");
+                exit(EXIT_FAILURE);
+        }
+        if (memoryLog == NULL)
+        {
+                perror("[Memory]: Can not create output file for memory\n");
+                exit(EXIT_FAILURE);
+        }
+        RenderEventLog("scheduler.events", log, memoryLog);
+        fclose(log);
+        fclose(memoryLog);
+}
+
+/**
+ * @brief End an interrupted run: write the events logged so far and render
+ * the logs from them. There's no scheduler.perf, the run didn't finish.
+ */
+void AbortScheduler()
+{
+        RemoveStatsPage();
+        RenderLogs();
+}
+
+/**
+ * @brief Close the logs and write scheduler.perf
+ */
+void FinishScheduler()
+{
+        RemoveStatsPage();
+        RenderLogs();
+
+        // Create output file
+        outputFile = fopen("scheduler.perf", "w");
+        if (outputFile == NULL)
+        {
+                perror("Schedular: Can not create performance file\n");
+                exit(EXIT_FAILURE);
+        }
+
+        double avgWTA = wtaStats.mean, avgWaiting = waitingStats.mean, stdDev = WelfordStdDev(&wtaStats);
+
+        // the utilization of the machine is the average of its CPUs
+        float cpUtilization = 0, cpuUtilizations[MAX_CPUS];
+        for (int cpu = 0; cpu < ncpu; cpu++)
+        {
+                cpuUtilizations[cpu] = (totalTime - idleTime[cpu] + 1) / (float)totalTime * 100;
+                cpUtilization += cpuUtilizations[cpu] / ncpu;
+#ifdef DEBUG
+                printf("total is %d, idle of cpu %d is %d\n", totalTime, cpu, idleTime[cpu]);
+#endif
+        }
+
+        fprintf(outputFile, "CPU utilization = %g %% \n", round(cpUtilization * 100.0) / 100.0);
+        fprintf(outputFile, "avg WTA: %g\navgWaiting:%g\nstd WTA:%g\n", round(avgWTA * 100.0) / 100.0, round(avgWaiting * 100.0) / 100.0, round(stdDev * 100.0) / 100.0);
+        ReportDeadlines(outputFile);
+        ReportLatency(outputFile);
+        if (highWater > 0)
+                fprintf(outputFile, "max waiting = %d (high-water mark %d)\n", maxWaiting, highWater);
+        for (int cpu = 0; cpu < ncpu && ncpu > 1; cpu++)
+        {
+                fprintf(outputFile, "CPU %d utilization = %g %% steals = %d\n",
+                        cpu, round(cpuUtilizations[cpu] * 100.0) / 100.0, steals[cpu]);
+        }
+        for (int cpu = 0; cpu < ncpu; cpu++)
+        {
+                if (policy[cpu]->report == NULL)
+                        continue;
+                if (ncpu > 1)
+                        fprintf(outputFile, "CPU %d:\n", cpu);
+                policy[cpu]->report(policy[cpu], outputFile);
+        }
+
+#ifdef DEBUG
+        printf("avg WTA = %g\navgWaiting = %g\nstd WTA = %g\n", round(avgWTA * 100.0) / 100.0, round(avgWaiting * 100.0) / 100.0, round(stdDev * 100.0) / 100.0);
+#endif
+        fclose(outputFile);
+        for (int class = 0; class <= PRIORITY_CLASSES; class++)
+        {
+                for (int stat = 0; stat < STATS; stat++)
+                        free(latency[class][stat]);
+        }
+        DestroyPCBPool();
+}
@@ -0,0 +1,44 @@
+/**
+ * @file sched_engine.h
+ * @brief The scheduling policies, their bookkeeping and the output files,
+ * independent of how the scheduled processes are run.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#ifndef _SCHED_ENGINE_H
+#define _SCHED_ENGINE_H
+
+#include "process_generator.h"
+#include "policy.h"
+
+#define MAX_CPUS 64
+
+/**
+ * @brief How the engine runs the process of a PCB. The scheduler forks and
+ * signals a process.out per PCB, the simulator only keeps the books.
+ */
+typedef struct
+{
+        int (*start)(PCB *pcb);   /**< run the PCB for the first time on pcb->cpu, returns the pid of its process */
+        void (*stop)(PCB *pcb);   /**< pause the running PCB */
+        void (*resume)(PCB *pcb); /**< continue a paused PCB on pcb->cpu, it may have moved */
+} dispatcher_t;
+
+extern PCB *running[MAX_CPUS];     /**< the PCB on every CPU, NULL if it's idle */
+extern policy_t *policy[MAX_CPUS]; /**< the run queue of every CPU, it owns the PCBs that wait there */
+extern int ncpu;                   /**< the number of CPUs */
+extern int nproc;                  /**< processes that didn't finish or get dropped yet */
+
+void InitScheduler(const char *spec, int numberOfProcesses, int quantum, int cpus, const dispatcher_t *disp);
+void SetHighWater(int mark);
+int ArrivalRoom();
+void CreateEntry(process_t proc, int curTime);
+void ProcFinished(PCB *pcb, int curTime);
+void Schedule(int curTime);
+int NextEvent(int curTime);
+void FinishScheduler();
+void AbortScheduler();
+void RemoveStatsPage();
+
+#endif /* _SCHED_ENGINE_H */
@@ -0,0 +1,100 @@
+/**
+ * @file schedtop.c
+ * @brief Watch a running scheduler or simulator: attach its stats page read
+ * only and show the counters every interval, with the ticks and the switches
+ * per second since the last refresh. It waits for a run to start and stops
+ * when the run is over.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include "stats_page.h"
+
+void Show(const stats_page_t *now, const stats_page_t *prev, double seconds);
+
+int main(int argc, char *argv[])
+{
+        int interval = 1000, iterations = -1, opt, shmid;
+
+        // schedtop.out [-i milliseconds] [-n refreshes]
+        while ((opt = getopt(argc, argv, "i:n:")) != -1)
+        {
+                if (opt == 'i' && atoi(optarg) > 0)
+                        interval = atoi(optarg);
+                else if (opt == 'n' && atoi(optarg) > 0)
+                        iterations = atoi(optarg);
+                else
+                {
+                        fprintf(stderr, "usage: %s [-i milliseconds] [-n refreshes]\n", argv[0]);
+                        exit(EXIT_FAILURE);
+                }
+        }
+
+        struct timespec sleep = {interval / 1000, (interval % 1000) * 1000000L};
+        stats_page_t *page;
+        while ((page = attachStatsPage(0, &shmid)) == NULL)
+        {
+                if (iterations == 0)
+                        exit(EXIT_FAILURE);
+                if (iterations > 0)
+                        iterations--;
+                nanosleep(&sleep, NULL);
+        }
+
+        stats_page_t now, prev;
+        struct timespec at, prevAt;
+        statsRead(page, &prev);
+        clock_gettime(CLOCK_MONOTONIC, &prevAt);
+
+        while (iterations != 0)
+        {
+                nanosleep(&sleep, NULL);
+                statsRead(page, &now);
+                clock_gettime(CLOCK_MONOTONIC, &at);
+
+                Show(&now, &prev, (at.tv_sec - prevAt.tv_sec) + (at.tv_nsec - prevAt.tv_nsec) / 1e9);
+                if (now.done)
+                        break;
+                prev = now;
+                prevAt = at;
+                if (iterations > 0)
+                        iterations--;
+        }
+        shmdt(page);
+}
+
+/**
+ * @brief Print the counters, over the previous ones if it's a terminal
+ *
+ * @param seconds since the previous counters were read
+ */
+void Show(const stats_page_t *now, const stats_page_t *prev, double seconds)
+{
+        int busy = 0;
+        for (int cpu = 0; cpu < now->ncpu; cpu++)
+                busy += now->running[cpu] != -1;
+
+        if (isatty(STDOUT_FILENO))
+                printf("\033[H\033[2J");
+
+        printf("schedtop - pid %d, tick %d (%.0f/s)%s\n", now->pid, now->tick,
+               (now->tick - prev->tick) / seconds, now->done ? ", done" : "");
+        printf("processes %d: running %d, waiting %d, finished %d, dropped %d\n", now->processes, busy, now->ready,
+               now->finished, now->dropped);
+        printf("switches %ld (%.0f/s)\n", now->switches, (now->switches - prev->switches) / seconds);
+        printf("memory %d of %d bytes in use, largest free block %d\n", now->memoryUsed, now->memorySize, now->largestFree);
+        printf("\n%4s %8s %8s %10s %10s\n", "CPU", "running", "waiting", "idle", "switches");
+        for (int cpu = 0; cpu < now->ncpu; cpu++)
+        {
+                if (now->running[cpu] != -1)
+                        printf("%4d %8d", cpu, now->running[cpu]);
+                else
+                        printf("%4d %8s", cpu, "-");
+                printf(" %8d %10d %10ld\n", now->cpuReady[cpu], now->idle[cpu], now->cpuSwitches[cpu]);
+        }
+        fflush(stdout);
+}
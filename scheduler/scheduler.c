@@ -2,56 +2,52 @@
  * @file scheduler.c
  * @author Ahmed Ashraf (ahmed.ashraf.cmp@gmail.com)
  * @brief Keeps track of the processes and their states and it decides which process will run and for how long.
+ * The policies live in sched_engine.c, this file runs them on a pool of process.out workers.
+ * A worker's slot in the pool is the control block of the PCB it runs, every CPU has a slot in the tick barrier.
+ * It sleeps in one epoll loop over the ticks and its signals, a finished process is an event of its tick.
  * @version 0.1
  * @date 2020-12-30
  */
 
-#define RQSZ 1000
-
-#include <math.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
 #include "headers.h"
-#include "process_generator.h"
-#include "priority_queue.h"
-
-/**
- * \struct 
- * @brief struct for messages of the message queue
- * 
- */
-struct msgbuff
-{
-        long mtype;
-        process_t proc;
-};
+#include "worker_pool.h"
+#include "arrival_ring.h"
+#include "sched_engine.h"
+#include "pcb_pool.h"
 
-key_t mqProcesses;
-PCB *running;
-struct Queue *readyQueue;
-int *shmRemainingTimeAd;
-int procGenFinished = 0;
+arrival_ring_t *ring;
 
-FILE *outputFile;
-FILE *memoryFile;
+// the workers, the idle ones are a stack of slots
+worker_pool_t *pool;
+int workerPids[WORKER_SLOTS], nworkers = 0;
+int idleWorkers[WORKER_SLOTS], nidle = 0;
 
-// Remaining time for current quantum
-int currQuantum, nproc, schedulerType, quantum;
-float avgWTA = 0, *WTAs, avgWaiting = 0;
-int numProcesses;
+// SIGPF, SIGINT and SIGTERM are read from it instead of being handled
+int sigFd;
+int interrupted = 0;
 
 // Functions declaration
-void ReadMSGQ(short wait);
-void CreateEntry(process_t entry);
-void HPFSheduler();
-void SRTNSheduler();
-void RRSheduler(int q);
-char *myItoa(int number);
-
-void ReadProcess(int signum);
-void ProcFinished(int signum);
+void RunTick(int curTime);
+int ReadSignals();
+void ReadArrivals(int curTime);
+int SpawnWorker();
+int StartProcess(PCB *pcb);
+void StopProcess(PCB *pcb);
+void ResumeProcess(PCB *pcb);
+void StopWorkers();
+void PrintDispatchLatency();
+void PrintArrivalRing();
+
+dispatcher_t processDispatcher = {StartProcess, StopProcess, ResumeProcess};
 
 /**
  * @brief the main program of the schulder.c
- * 
+ *
  * @param argc the number of the arguments passed
  * @param argv array of string containing the arguments
  * @return int 0 if everything is okay
@@ -61,551 +57,347 @@ int main(int argc, char *argv[])
         //attach to clock
         initClk();
 
-        // Create output file
-        outputFile = fopen("scheduler.log", "w");
-        memoryFile = fopen("memory.log", "w");
-        if (outputFile == NULL)
-        {
-                perror("Schedular: Can not create output file\n");
-                exit(EXIT_FAILURE);
-        }
-        if (memoryFile == NULL)
-        {
-                perror("[Memory]: Can not create output file for memory\n");
-                exit(EXIT_FAILURE);
-        }
-
-        fprintf(memoryFile, "#At time x allocated y bytes from process z from i to j \n");
-        fprintf(outputFile, "#At time x process y state arr w total z remain y wait k\n");
-
-        //initialize variables
-        readyQueue = CreateQueue(RQSZ);
-        running = NULL;
-
         //parse arguments
         if (argc < 4)
         {
                 perror("Scheduler: Not enough argument\n");
                 exit(EXIT_FAILURE);
         }
+        int cpus = argc > 4 ? atoi(argv[4]) : 1;
 
-        schedulerType = atoi(argv[1]);
-        nproc = atoi(argv[2]);
-        numProcesses = nproc;
-        WTAs = (float *)malloc(sizeof(float) * numProcesses);
-        quantum = atoi(argv[3]);
+        InitScheduler(argv[1], atoi(argv[2]), atoi(argv[3]), cpus, &processDispatcher);
+        if (argc > 5)
+                SetHighWater(atoi(argv[5]));
+        int poolSize = argc > 6 ? atoi(argv[6]) : WORKER_POOL_DEFAULT;
 
-        //bind used signals
-        signal(SIGMSGQ, ReadProcess);
-        signal(SIGPF, ProcFinished);
-
-        // message queue
-        mqProcesses = msgget(MSGQKEY, 0644);
-        if (mqProcesses == -1)
+        // the clock adds one to it on every tick
+        int tickFd = argc > 7 ? atoi(argv[7]) : -1;
+        if (tickFd == -1 || fcntl(tickFd, F_SETFD, FD_CLOEXEC) == -1)
         {
-                perror("\n\nScheduler: Failed to get the message queue\n");
+                perror("Scheduler: no tick eventfd\n");
                 exit(EXIT_FAILURE);
         }
 
-        // shared memory remaining time
-        key_t shmRemainingTime = shmget(PRSHKEY, 4, IPC_CREAT | 0644);
-        if (shmRemainingTime == -1)
+        // every SIGPF is queued with the pid of the worker that sent it, the
+        // others end the run
+        sigset_t sigMask;
+        sigemptyset(&sigMask);
+        sigaddset(&sigMask, SIGPF);
+        sigaddset(&sigMask, SIGINT);
+        sigaddset(&sigMask, SIGTERM);
+        sigprocmask(SIG_BLOCK, &sigMask, NULL);
+        sigFd = signalfd(-1, &sigMask, SFD_NONBLOCK | SFD_CLOEXEC);
+
+        int epollFd = epoll_create1(EPOLL_CLOEXEC);
+        struct epoll_event tickEvent = {.events = EPOLLIN, .data.fd = tickFd};
+        struct epoll_event sigEvent = {.events = EPOLLIN, .data.fd = sigFd};
+        if (sigFd == -1 || epollFd == -1 ||
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, tickFd, &tickEvent) == -1 ||
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, sigFd, &sigEvent) == -1)
         {
-                perror("Scheduler: Failed to get the shared memory\n");
+                perror("Scheduler: Failed to set up the event loop\n");
                 exit(EXIT_FAILURE);
         }
 
-        // attach to it
-        shmRemainingTimeAd = (int *)shmat(shmRemainingTime, (void *)0, 0);
-        if ((long)shmRemainingTimeAd == -1)
-        {
-                perror("\n\nError in attaching the shm in scheduler!\n");
-                exit(EXIT_FAILURE);
-        }
+        // the generator created the ring before it forked us
+        int ringShm;
+        ring = attachArrivalRing(0, &ringShm);
 
-        //Semaphore semSchedProc
-        int semSchedProc = semget(SEM_SCHED_PROC_KEY, 1, 0666 | IPC_CREAT);
+        // fork the workers before the first dispatch, more are forked if they're all busy
+        int poolShm;
+        pool = attachWorkerPool(1, &poolShm);
+        memset(pool, 0, sizeof(worker_pool_t));
+        while (nworkers < poolSize && nworkers < WORKER_SLOTS)
+                idleWorkers[nidle++] = SpawnWorker();
 
-        if (semSchedProc == -1)
-        {
-                perror("Error in create sem");
-                exit(EXIT_FAILURE);
-        }
-
-        union Semun semun;
-        semun.val = 0;
-        if (semctl(semSchedProc, 0, SETVAL, semun) == -1)
-        {
-                perror("Error in semctl");
-                exit(-1);
-        }
-
-        //Semaphore semSchedGen
-        int semSchedGen = semget(SEM_SCHED_GEN_KEY, 1, 0666);
-
-        if (semSchedGen == -1)
-        {
-                perror("Error in create sem");
-                exit(EXIT_FAILURE);
-        }
-
-	int totalTime = 0, idleTime = 0;
         int curTime = -1;
-        while (nproc)
+        while (nproc && !interrupted)
         {
+                struct epoll_event events[2];
+                int nevents = epoll_wait(epollFd, events, 2, -1);
+                if (nevents == -1 && errno != EINTR)
+                {
+                        perror("Scheduler: epoll_wait failed\n");
+                        exit(EXIT_FAILURE);
+                }
 
-                if (getClk() == curTime)
-                        continue;
-                curTime = getClk();
-		totalTime++;
-                if (procGenFinished == 0)
-                        down(semSchedGen);
-                if (running != NULL)
-                        down(semSchedProc);
-
-                ReadMSGQ(0);
-
-                if (!IsEmpty(readyQueue))
+                for (int i = 0; i < nevents && !interrupted; i++)
                 {
-                        switch (schedulerType)
+                        if (events[i].data.fd == sigFd)
                         {
-                        case 0:
-                                SRTNSheduler();
-                                break;
-
-                        case 1:
-                                RRSheduler(quantum);
-                                break;
-
-                        default:
-                                HPFSheduler();
-                                break;
+                                interrupted = ReadSignals();
+                                continue;
                         }
+
+                        // several ticks may have passed, only the current one counts
+                        uint64_t ticks;
+                        if (read(tickFd, &ticks, sizeof(ticks)) == -1)
+                                continue;
+                        int now = getClk();
+                        if (now == curTime)
+                                continue;
+                        curTime = now;
+                        RunTick(curTime);
                 }
-		else if (!running) {
-			idleTime++;
-			printf("current time is %d and idle time is %d\n", getClk(), idleTime);
-			}
         }
 
-        // upon termination release the clock resources.
-        destroyClk(false);
-        if (semctl(semSchedProc, 1, IPC_RMID) == -1)
+        if (interrupted)
         {
-                perror("scheduler: can't remove semaphore semSchedProc \n");
+                // the clock may be gone already, the workers can't be let go
+                for (int slot = 0; slot < nworkers; slot++)
+                        kill(workerPids[slot], SIGKILL);
+                for (int slot = 0; slot < nworkers; slot++)
+                        waitpid(workerPids[slot], NULL, 0);
+                shmdt(pool);
+                shmctl(poolShm, IPC_RMID, (struct shmid_ds *)0);
+                AbortScheduler();
+                fprintf(stderr, "Scheduler: interrupted at time %d\n", curTime);
+                exit(EXIT_FAILURE);
         }
 
-        if (shmdt(shmRemainingTimeAd) == -1)
-        {
-                printf("scheduler: error in detaching a shared memory\n");
-        }
+        // upon termination release the clock resources.
+        clkLeave(CLK_SCHED);
+        StopWorkers();
+        destroyClk(false);
 
-        if (shmctl(shmRemainingTime, IPC_RMID, (struct shmid_ds *)0) == -1)
-        {
-                perror("scheduler: can't remove remaining time schared memory \n");
-        }
-        fclose(outputFile);
+        PrintDispatchLatency();
+        PrintArrivalRing();
+        shmdt(ring);
+        shmdt(pool);
+        shmctl(poolShm, IPC_RMID, (struct shmid_ds *)0);
 
-        // Create output file
-        outputFile = fopen("scheduler.perf", "w");
-        if (outputFile == NULL)
+        FinishScheduler();
+}
+
+/**
+ * @brief Run the tick once everybody that has to arrived at its barrier. The
+ * processes that finished in it are handled together, in the order of their CPUs.
+ *
+ * @param curTime the current tick
+ */
+void RunTick(int curTime)
+{
+        // the generator has sent this tick's arrivals, it doesn't hold us once it left
+        tickWait(CLK_GEN, curTime);
+        for (int cpu = 0; cpu < ncpu; cpu++)
         {
-                perror("Schedular: Can not create performance file\n");
-                exit(EXIT_FAILURE);
-        }
+                if (running[cpu] == NULL)
+                        continue;
 
-        avgWTA /= numProcesses;
-        avgWaiting /= numProcesses;
+                tickWait(CLK_WORKER(cpu), curTime);
+                running[cpu]->remainingTime = pool->slots[running[cpu]->worker].remaining;
+        }
 
-        float stdDev = 0;
-        for (int i = 0; i < numProcesses; i++)
+        // a worker sends SIGPF before it arrives, so they're all queued by now
+        interrupted |= ReadSignals();
+        for (int cpu = 0; cpu < ncpu; cpu++)
         {
-                stdDev += pow((double)(WTAs[i] - avgWTA), 2);
+                if (running[cpu] != NULL && running[cpu]->state == FINISHED)
+                {
+                        // its worker went idle before it sent SIGPF
+                        idleWorkers[nidle++] = running[cpu]->worker;
+                        ProcFinished(running[cpu], curTime);
+                }
         }
 
-        stdDev = sqrt(stdDev);
+        ReadArrivals(curTime);
 
-	float cpUtilization = (totalTime - idleTime+1) / (float)totalTime * 100;	
-	printf("total is %d, idle is %d\n", totalTime, idleTime);
-        fprintf(outputFile, "CPU utilization = %g %% \n", round(cpUtilization * 100.0) / 100.0);
-        fprintf(outputFile, "avg WTA: %g\navgWaiting:%g\nstd WTA:%g\n", round(avgWTA * 100.0) / 100.0, round(avgWaiting * 100.0) / 100.0, round(stdDev * 100.0) / 100.0);
+        Schedule(curTime);
 
-#ifdef DEBUG
-        printf("avg WTA = %g\navgWaiting = %g\nstd WTA = %g\n", round(avgWTA * 100.0) / 100.0, round(avgWaiting * 100.0) / 100.0, round(stdDev * 100.0) / 100.0);
-#endif
-        fclose(outputFile);
-        fclose(memoryFile);
-        free(WTAs);
+        // published before arriving, the generator reads it at the next tick
+        __atomic_store_n(&clkShm->arrivalRoom, ArrivalRoom(), __ATOMIC_RELEASE);
+        clkDone(CLK_SCHED, NextEvent(curTime));
 }
 
 /**
- * @brief Signal handler for the SIGUSR to handle arriving of a new process
+ * @brief Read the queued signals. A SIGPF marks the PCB of the worker that sent
+ * it finished, it's looked up by the worker's pid.
  *
- * @param signum SIGUSR flag
+ * @return int 1 if SIGINT or SIGTERM was read, 0 otherwise
  */
-void ReadProcess(int signum)
+int ReadSignals()
 {
-        procGenFinished = 1;
+        struct signalfd_siginfo infos[64];
+        int stop = 0;
+        ssize_t bytes;
+
+        while ((bytes = read(sigFd, infos, sizeof(infos))) > 0)
+        {
+                for (int i = 0; i < bytes / (ssize_t)sizeof(infos[0]); i++)
+                {
+                        if ((int)infos[i].ssi_signo != SIGPF)
+                        {
+                                stop = 1;
+                                continue;
+                        }
+
+                        PCB *pcb = PCBByPid(infos[i].ssi_pid);
+                        if (pcb != NULL)
+                                pcb->state = FINISHED;
+                }
+        }
+        return stop;
 }
 
 /**
- * @brief this a handler of SIGPF signal of this process to handle
- * when a process is finished.
- * 
- * @param signum SIGPF
+ * @brief Push every process the generator published to the ready queue, they
+ * are read in place and given back to the generator at once
+ * @param curTime the current tick
  */
-void ProcFinished(int signum)
+void ReadArrivals(int curTime)
 {
-        int ta = getClk() - running->arrivalTime;
-        float wta = ((float)ta) / running->runTime;
-
-        avgWaiting += running->waitingTime;
-        avgWTA += wta;
-
-        WTAs[running->id - 1] = wta;
-
-        running->remainingTime = *shmRemainingTimeAd;
+        int n = arrivalRingCount(ring);
 
-#ifdef DEBUG
-        printf("At time %d freed %d bytes from process %d from %d to %d \n", getClk(), running->memoryNode->data, running->id, running->memoryNode->start, running->memoryNode->end);
-#endif
-        fprintf(memoryFile, "At time %d freed %d bytes from process %d from %d to %d \n", getClk(), running->memoryNode->data, running->id, running->memoryNode->start, running->memoryNode->end);
-        Deallocate(running->memoryNode);
+        for (int i = 0; i < n; i++)
+                CreateEntry(*arrivalSlot(ring, ring->tail + i), curTime);
 
-        fprintf(outputFile, "At time %d process %d finished arr %d total %d remain %d wait %d TA %d WTA %g\n",
-                getClk(), running->id, running->arrivalTime, running->runTime, running->remainingTime, running->waitingTime,
-                ta, round(wta * 100.0) / 100.0);
-
-#ifdef DEBUG
-        printf("At time %d process %d finished arr %d total %d remain %d wait %d TA %d WTA %0.2g\n",
-               getClk(), running->id, running->arrivalTime, running->runTime, running->remainingTime, running->waitingTime,
-               ta, wta);
-#endif
-
-        int stat;
-        waitpid(running->pid, &stat, 0);
-        free(running);
-        running = NULL;
-        nproc--;
-
-        //rebind the signal handler
-        signal(SIGPF, ProcFinished);
+        arrivalRingRelease(ring, n);
 }
 
 /**
- * @brief Reads the message queue and push the new processes
- * to the ready queue
- * @param wait 1 if it has to wait 0 otherwise
+ * @brief Fork a process.out for the next slot of the pool. A worker forked
+ * for a dispatch finds its slot assigned already.
+ *
+ * @return int the slot
  */
-void ReadMSGQ(short wait)
+int SpawnWorker()
 {
-        while (1)
+        int pid, slot = nworkers;
+        char slotArg[12];
+
+        if (slot == WORKER_SLOTS)
         {
-                int recVal;
-                struct msgbuff msg;
+                fprintf(stderr, "scheduler: more than %d processes started at once\n", WORKER_SLOTS);
+                exit(EXIT_FAILURE);
+        }
+        snprintf(slotArg, sizeof(slotArg), "%d", slot);
 
-                // Try to recieve the new process
-                recVal = msgrcv(mqProcesses, &msg, sizeof(msg.proc), 0, wait ? !IPC_NOWAIT : IPC_NOWAIT);
-                if (recVal == -1)
+        if ((pid = fork()) == 0)
+        {
+                // the blocked signals would stay blocked after exec
+                sigset_t none;
+                sigemptyset(&none);
+                sigprocmask(SIG_SETMASK, &none, NULL);
+
+                int rt = execl("build/process.out", "process.out", slotArg, NULL);
+                if (rt == -1)
                 {
-                        // If there is no process recieved then break
-                        break;
+                        perror("scheduler: couldn't run process.out\n");
+                        exit(EXIT_FAILURE);
                 }
-
-                // If successfuly recieved the new process add it to the ready queue
-                CreateEntry(msg.proc);
         }
+        else if (pid == -1)
+        {
+                perror("scheduler: couldn't fork a worker\n");
+                exit(EXIT_FAILURE);
+        }
+
+        workerPids[nworkers++] = pid;
+        return slot;
 }
 
 /**
- * @brief Create a PCB object and insert it in the ready queue
- * 
- * @param entry process object
+ * @brief Hand the PCB to an idle worker, or fork one if they're all busy,
+ * with its remaining time and its CPU
+ *
+ * @param pcb the PCB to run
+ * @return int the pid of the worker
  */
-void CreateEntry(process_t proc)
+int StartProcess(PCB *pcb)
 {
-        PCB *entry = (PCB *)malloc(sizeof(PCB));
-        entry->id = proc.id;
-        entry->arrivalTime = proc.arrivalTime;
-        entry->runTime = proc.runTime;
-        entry->priority = proc.priority;
-        entry->state = READY;
-        entry->remainingTime = proc.runTime;
-        entry->waitingTime = 0;
-        entry->memoryNode = Allocate(proc.memSize);
-        if (entry->memoryNode == NULL)
-        {
-#ifdef DEBUG
-                printf("----- At time %d couldn't allocate %d bytes for process %d ------ \n", getClk(), proc.memSize, entry->id);
-#endif
-                free(entry);
-                nproc--;
-        }
+        long long decided = monoNs();
+        int forked = nidle == 0;
+
+        pcb->worker = forked ? nworkers : idleWorkers[--nidle];
+        worker_slot_t *slot = &pool->slots[pcb->worker];
+        slot->cpu = pcb->cpu;
+        slot->remaining = pcb->remainingTime;
+        slot->since = getClk();
+        slot->path = forked ? DISPATCH_FORKED : DISPATCH_WOKEN;
+        slot->dispatchNs = decided;
+        __atomic_store_n(&slot->ctl, WORKER_RUNNING, __ATOMIC_RELEASE);
+
+        // a forked worker finds its slot running
+        if (forked)
+                SpawnWorker();
         else
-        {
-                switch (schedulerType)
-                {
-                case 0:
-                        entry->priority = entry->remainingTime;
-                        InsertValue(readyQueue, entry);
-                        // if(running) SRTNSheduler();  // Should be called again to check that the current runnning proc is the SRTN
-                        break;
-                case 1:
-                        Enqueue(readyQueue, entry);
-                        break;
-                case 2:
-                        InsertValue(readyQueue, entry);
-                        break;
-                default:
-                        break;
-                }
+                futexWake(&slot->ctl);
 
-#ifdef DEBUG
-                printf("At time %d allocated %d bytes for process %d from %d to %d \n", getClk(), entry->memoryNode->data, entry->id, entry->memoryNode->start, entry->memoryNode->end);
-#endif
-                fprintf(memoryFile, "At time %d allocated %d bytes for process %d from %d to %d \n", getClk(), entry->memoryNode->data, entry->id, entry->memoryNode->start, entry->memoryNode->end);
-        }
+        return workerPids[pcb->worker];
 }
 
 /**
- * @brief Schedule the processes using Non-preemptive Highest Priority First 
- * 
+ * @brief Stop a running process. Its worker sees it at the next tick, before
+ * it counts the tick, and sleeps until it's resumed.
+ *
+ * @param pcb the PCB of the process
  */
-void HPFSheduler()
+void StopProcess(PCB *pcb)
 {
-        if (running == NULL)
-        {
-                running = ExtractMin(readyQueue);
-
-                // Start a new process. (Fork it and give it its parameters.)
-                *shmRemainingTimeAd = running->remainingTime;
-
-                // Setting waiting time
-                running->waitingTime = getClk() - running->arrivalTime;
-
-                fprintf(outputFile, "At time %d process %d started arr %d total %d remain %d wait %d\n",
-                        getClk(), running->id, running->arrivalTime, running->runTime, running->remainingTime, running->waitingTime);
-
-#ifdef DEBUG
-                printf("At time %d process %d started arr %d total %d remain %d wait %d\n",
-                       getClk(), running->id, running->arrivalTime, running->runTime, running->remainingTime, running->waitingTime);
-#endif
+        __atomic_store_n(&pool->slots[pcb->worker].ctl, WORKER_STOPPED, __ATOMIC_RELEASE);
+}
 
-                int pid;
-                if ((pid = fork()) == 0)
-                {
-                        int rt = execl("build/process.out", "process.out", NULL);
+/**
+ * @brief Continue a stopped process on pcb->cpu, it counts the ticks from now on
+ *
+ * @param pcb the PCB of the process
+ */
+void ResumeProcess(PCB *pcb)
+{
+        worker_slot_t *slot = &pool->slots[pcb->worker];
 
-                        if (rt == -1)
-                        {
-                                perror("\n\nScheduler: couldn't run scheduler.out\n");
-                                exit(EXIT_FAILURE);
-                        }
-                }
-                else
-                {
-                        running->pid = pid;
-                }
-        }
-        else
-                running->remainingTime = *shmRemainingTimeAd;
+        slot->cpu = pcb->cpu;
+        slot->since = getClk();
+        __atomic_store_n(&slot->ctl, WORKER_RUNNING, __ATOMIC_RELEASE);
+        futexWake(&slot->ctl);
 }
 
 /**
- * @brief Schedule the processes using Shortest Remaining time Next
- * 
+ * @brief Let the workers go and wait for them, they're all idle once every PCB finished
  */
-void SRTNSheduler()
+void StopWorkers()
 {
-        if (running)
+        for (int slot = 0; slot < nworkers; slot++)
         {
-                PCB *nextProc = Minimum(readyQueue);
-                running->remainingTime = *shmRemainingTimeAd;
-                running->priority = *shmRemainingTimeAd;
-
-                if (running->remainingTime > nextProc->remainingTime) // Context Switching
-                {
-
-                        fprintf(outputFile, "At time %d process %d stopped arr %d total %d remain %d wait %d\n",
-                                getClk(), running->id, running->arrivalTime, running->runTime, running->remainingTime, running->waitingTime);
-
-#ifdef DEBUG
-                        printf("At time %d process %d stopped arr %d total %d remain %d wait %d\n",
-                               getClk(), running->id, running->arrivalTime, running->runTime, running->remainingTime, running->waitingTime);
-#endif
-                        running->state = BLOCKED;
-                        running->waitStart = getClk();
-                        InsertValue(readyQueue, running);
-                        kill(running->pid, SIGSLP);
-                }
-                else
-                        return;
-        }
-
-        if (running == NULL || running->state == BLOCKED)
-        {
-                running = ExtractMin(readyQueue);
-                if (running->state == READY)
-                {
-
-                        int pid;
-
-                        *shmRemainingTimeAd = running->remainingTime;
-
-                        // Setting initial waiting time
-                        running->waitingTime = getClk() - running->arrivalTime;
-
-                        fprintf(outputFile, "At time %d process %d started arr %d total %d remain %d wait %d\n",
-                                getClk(), running->id, running->arrivalTime, running->runTime, running->remainingTime, running->waitingTime);
-
-#ifdef DEBUG
-                        printf("At time %d process %d started arr %d total %d remain %d wait %d\n",
-                               getClk(), running->id, running->arrivalTime, running->runTime, running->remainingTime, running->waitingTime);
-#endif
-
-                        if ((pid = fork()) == 0)
-                        {
-                                int rt = execl("build/process.out", "process.out", NULL);
-                                if (rt == -1)
-                                {
-                                        perror("\n\nScheduler: couldn't run scheduler.out\n");
-                                        exit(EXIT_FAILURE);
-                                }
-                        }
-                        else
-                        {
-                                running->pid = pid;
-                        }
-                }
-                else if (running->state == BLOCKED)
-                {
-                        kill(running->pid, SIGSLP);
-                        running->state = READY;
-                        running->waitingTime += getClk() - running->waitStart;
-
-                        fprintf(outputFile, "At time %d process %d resumed arr %d total %d remain %d wait %d\n",
-                                getClk(), running->id, running->arrivalTime, running->runTime, running->remainingTime, running->waitingTime);
-
-#ifdef DEBUG
-                        printf("At time %d process %d resumed arr %d total %d remain %d wait %d\n",
-                               getClk(), running->id, running->arrivalTime, running->runTime, running->remainingTime, running->waitingTime);
-#endif
-                }
+                __atomic_store_n(&pool->slots[slot].ctl, WORKER_EXIT, __ATOMIC_RELEASE);
+                futexWake(&pool->slots[slot].ctl);
         }
+        for (int slot = 0; slot < nworkers; slot++)
+                waitpid(workerPids[slot], NULL, 0);
 }
 
 /**
- * @brief Schedule the processes using Round Robin
- * 
+ * @brief Print how long the dispatches took from the decision to start a PCB
+ * to its worker picking it up, the forked workers apart from the woken ones
  */
-
-void RRSheduler(int quantum)
+void PrintDispatchLatency()
 {
-        if (running)
-        {
-                currQuantum--;
-                running->remainingTime = *shmRemainingTimeAd;
-                if (currQuantum == 0)
-                {
-                        Enqueue(readyQueue, running);
-                        kill(running->pid, SIGSLP);
-                        running->state = BLOCKED;
-                        running->waitStart = getClk();
-
-                        fprintf(outputFile, "At time %d process %d stopped arr %d total %d remain %d wait %d\n",
-                                getClk(), running->id, running->arrivalTime, running->runTime, running->remainingTime, running->waitingTime);
-
-#ifdef DEBUG
-                        printf("At time %d process %d stopped arr %d total %d remain %d wait %d\n",
-                               getClk(), running->id, running->arrivalTime, running->runTime, running->remainingTime, running->waitingTime);
-#endif
-                }
-                else
-                        return;
-        }
+        const char *paths[DISPATCH_PATHS] = {"forked", "woken"};
 
-        currQuantum = quantum;
-        running = Dequeue(readyQueue);
-        if (running->state == READY)
+        printf("Dispatch latency: %d workers, path count avg(us) max(us)\n", nworkers);
+        for (int path = 0; path < DISPATCH_PATHS; path++)
         {
-                // Start a new process. (Fork it and give it its parameters.)
-                int pid;
-                *shmRemainingTimeAd = running->remainingTime;
-
-                // Setting initial waiting time
-                running->waitingTime = getClk() - running->arrivalTime;
-
-                fprintf(outputFile, "At time %d process %d started arr %d total %d remain %d wait %d\n",
-                        getClk(), running->id, running->arrivalTime, running->runTime, running->remainingTime, running->waitingTime);
-
-#ifdef DEBUG
-                printf("At time %d process %d started arr %d total %d remain %d wait %d\n",
-                       getClk(), running->id, running->arrivalTime, running->runTime, running->remainingTime, running->waitingTime);
-#endif
+                if (pool->dispatches[path] == 0)
+                        continue;
 
-                if ((pid = fork()) == 0)
-                {
-                        int rt = execl("build/process.out", "process.out", NULL);
-                        if (rt == -1)
-                        {
-                                perror("scheduler: couldn't run scheduler.out\n");
-                                exit(EXIT_FAILURE);
-                        }
-                }
-                else
+                printf("Dispatch latency: %s %lld %.1f %.1f\n", paths[path], pool->dispatches[path],
+                       pool->latencyNs[path] / 1000.0 / pool->dispatches[path], pool->maxLatencyNs[path] / 1000.0);
+                for (int bucket = 0; bucket < DISPATCH_BUCKETS; bucket++)
                 {
-                        running->pid = pid;
+                        if (pool->latencies[path][bucket] != 0)
+                                printf("Dispatch latency: %s < %lld us: %lld\n", paths[path],
+                                       1LL << bucket, pool->latencies[path][bucket]);
                 }
         }
-        else if (running->state == BLOCKED)
-        {
-                kill(running->pid, SIGSLP);
-                running->state = READY;
-                running->waitingTime += getClk() - running->waitStart;
-
-                fprintf(outputFile, "At time %d process %d resumed arr %d total %d remain %d wait %d\n",
-                        getClk(), running->id, running->arrivalTime, running->runTime, running->remainingTime, running->waitingTime);
-
-#ifdef DEBUG
-                printf("At time %d process %d resumed arr %d total %d remain %d wait %d\n",
-                       getClk(), running->id, running->arrivalTime, running->runTime, running->remainingTime, running->waitingTime);
-#endif
-        }
 }
 
 /**
- * @brief convert an integer to a null terminated string.
- * 
- * @param number the number to convert.
- * @return char* a pointer to the converted string.
+ * @brief Print how many arrivals went through the ring per tick and how full it got
  */
-char *myItoa(int number)
+void PrintArrivalRing()
 {
-        uint8_t ch;
-        int numberSize = 0;
-        char *numberStr = NULL;
-        if (number != 0)
-        {
-                while ((ch = number % 10))
-                {
-                        number /= 10;
-
-                        numberSize++;
-                        numberStr = (char *)realloc(numberStr, numberSize);
-                        numberStr[numberSize - 1] = ch + '0';
-                }
-        }
-        else
-        {
-                numberSize++;
-                numberStr = (char *)realloc(numberStr, numberSize);
-                numberStr[numberSize - 1] = '0';
-        }
-
-        //null terminate the string
-        numberSize++;
-        numberStr = (char *)realloc(numberStr, numberSize);
-        numberStr[numberSize - 1] = '\0';
-
-        return numberStr;
-}
\ No newline at end of file
+        printf("Arrival ring: %lld delivered in %d ticks, avg %.1f max %d per tick\n", ring->delivered, ring->drains,
+               ring->drains ? (double)ring->delivered / ring->drains : 0.0, ring->maxDelivered);
+        printf("Arrival ring: max occupancy %d of %d, full in %d ticks\n", ring->maxOccupancy, ARRIVAL_RING_SIZE,
+               ring->fullTicks);
+}
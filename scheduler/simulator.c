@@ -0,0 +1,143 @@
+/**
+ * @file simulator.c
+ * @brief Runs the scheduling policies in a single process. Nothing is forked and
+ * there's no clock, the remaining times are advanced directly and time jumps
+ * straight to the next arrival, finish or quantum expiry. It writes the same
+ * scheduler.log, memory.log and scheduler.perf as the scheduler.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <signal.h>
+#include "sched_engine.h"
+#include "trace.h"
+
+int StartNothing(PCB *pcb);
+void SignalNothing(PCB *pcb);
+void Interrupt(int signum);
+
+dispatcher_t simDispatcher = {StartNothing, SignalNothing, SignalNothing};
+
+volatile sig_atomic_t interrupted = 0;
+
+int main(int argc, char *argv[])
+{
+        int numberOfProcesses;
+        char schedOption[POLICY_SPEC_SIZE];
+        int quantum;
+        int cpus = 1;
+        int highWater = 0;
+        int opt;
+
+        // simulator.out [-c cpus] [-w high-water mark] [trace]
+        while ((opt = getopt(argc, argv, "c:w:")) != -1)
+        {
+                if (opt == 'c')
+                        cpus = atoi(optarg);
+                else if (opt == 'w')
+                        highWater = atoi(optarg);
+                else
+                {
+                        fprintf(stderr, "usage: %s [-c cpus] [-w high-water mark] [trace]\n", argv[0]);
+                        exit(EXIT_FAILURE);
+                }
+        }
+        const char *fileName = optind < argc ? argv[optind] : "processes.txt";
+
+        // the generator releases the processes in arrival order too
+        struct TraceReader *trace = OpenTrace(fileName, cpus);
+        numberOfProcesses = trace->count;
+
+        ReadPolicy("simulator", schedOption, &quantum);
+
+        InitScheduler(schedOption, numberOfProcesses, quantum, cpus, &simDispatcher);
+        SetHighWater(highWater);
+
+        // an interrupted run stops at the next tick and writes its logs
+        signal(SIGINT, Interrupt);
+        signal(SIGTERM, Interrupt);
+
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+
+        int curTime = 0, prevTime = 0, room = INT_MAX;
+        const process_t *proc;
+        while (nproc)
+        {
+                if (interrupted)
+                {
+                        AbortScheduler();
+                        fprintf(stderr, "simulator: interrupted at time %d\n", curTime);
+                        exit(EXIT_FAILURE);
+                }
+
+                // the running processes ran for every tick since the last one
+                for (int cpu = 0; cpu < ncpu; cpu++)
+                {
+                        if (running[cpu] == NULL)
+                                continue;
+                        running[cpu]->remainingTime -= curTime - prevTime;
+                        if (running[cpu]->remainingTime <= 0)
+                        {
+                                running[cpu]->remainingTime = 0;
+                                ProcFinished(running[cpu], curTime);
+                        }
+                }
+
+                // like the generator, only as many arrive as the last tick left room
+                // for under the high-water mark
+                while (room > 0 && (proc = PeekProcess(trace)) != NULL && proc->arrivalTime <= curTime)
+                {
+                        CreateEntry(*proc, curTime);
+                        SkipProcess(trace);
+                        room--;
+                }
+
+                Schedule(curTime);
+                room = ArrivalRoom();
+
+                // jump to the next tick something happens at, like the virtual clock.
+                // Held arrivals are overdue, so they're tried again at the next tick
+                int next = NextEvent(curTime);
+                if ((proc = PeekProcess(trace)) != NULL && proc->arrivalTime < next)
+                        next = proc->arrivalTime;
+                if (next <= curTime || next == INT_MAX)
+                        next = curTime + 1;
+
+                prevTime = curTime;
+                curTime = next;
+        }
+
+        // the time the policy took, to compare the policies on big traces
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        fprintf(stderr, "simulator: scheduled %d processes in %.3f s\n", numberOfProcesses,
+               (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9);
+
+        FinishScheduler();
+        CloseTrace(trace);
+}
+
+/**
+ * @brief Stop the run at the next tick, see main()
+ */
+void Interrupt(int signum)
+{
+        interrupted = 1;
+}
+
+/**
+ * @brief The simulated processes only live in their PCBs, they have no pid
+ */
+int StartNothing(PCB *pcb)
+{
+        return 0;
+}
+
+void SignalNothing(PCB *pcb)
+{
+}
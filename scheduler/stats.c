@@ -0,0 +1,91 @@
+/**
+ * @file stats.c
+ * @brief Statistics of the finished processes in constant memory: the mean
+ * and the variance by Welford's method, and log-linear histograms in the
+ * manner of HdrHistogram for the percentiles
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#include <math.h>
+#include "stats.h"
+
+/**
+ * @brief Add a value to the mean and the variance
+ */
+void WelfordAdd(welford_t *w, double x)
+{
+        w->n++;
+        double delta = x - w->mean;
+        w->mean += delta / w->n;
+        w->m2 += delta * (x - w->mean);
+}
+
+/**
+ * @brief The standard deviation of the values added, 0 if there are none
+ */
+double WelfordStdDev(const welford_t *w)
+{
+        return w->n > 0 ? sqrt(w->m2 / w->n) : 0;
+}
+
+/**
+ * @brief The bucket of a value, see histogram_t
+ */
+static int BucketOf(unsigned value)
+{
+        if (value < 2 * HIST_SUB)
+                return value;
+        int shift = 31 - __builtin_clz(value) - HIST_SUB_BITS;
+        return shift * HIST_SUB + (value >> shift);
+}
+
+/**
+ * @brief The largest value of a bucket
+ */
+static unsigned BucketTop(int bucket)
+{
+        if (bucket < 2 * HIST_SUB)
+                return bucket;
+        int shift = bucket / HIST_SUB - 1;
+        unsigned sub = bucket % HIST_SUB + HIST_SUB;
+        return ((sub + 1) << shift) - 1;
+}
+
+/**
+ * @brief Count a value, the negative ones count as 0
+ */
+void HistogramAdd(histogram_t *h, int value)
+{
+        if (value < 0)
+                value = 0;
+        h->buckets[BucketOf(value)]++;
+        h->count++;
+        if (value > h->max)
+                h->max = value;
+}
+
+/**
+ * @brief The value a share of the counted values is at or below
+ *
+ * @param q the share, from 0 to 1
+ * @return int the largest value of its bucket, never more than the largest
+ * value counted. 0 if nothing was counted.
+ */
+int HistogramPercentile(const histogram_t *h, double q)
+{
+        long rank = (long)ceil(q * h->count), seen = 0;
+        if (rank < 1)
+                rank = 1;
+
+        for (int bucket = 0; bucket < HIST_BUCKETS && h->count > 0; bucket++)
+        {
+                seen += h->buckets[bucket];
+                if (seen >= rank)
+                {
+                        unsigned top = BucketTop(bucket);
+                        return top < (unsigned)h->max ? (int)top : h->max;
+                }
+        }
+        return h->max;
+}
@@ -0,0 +1,43 @@
+/**
+ * @file stats.h
+ * @brief Statistics of the finished processes in constant memory: the mean
+ * and the variance by Welford's method, and log-linear histograms in the
+ * manner of HdrHistogram for the percentiles
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#ifndef _STATS_H
+#define _STATS_H
+
+#define HIST_SUB_BITS 7                 /**< 128 buckets per power of 2, a percentile is off by less than 1% */
+#define HIST_SUB (1 << HIST_SUB_BITS)
+#define HIST_BUCKETS ((32 - HIST_SUB_BITS) * HIST_SUB) /**< every non-negative int */
+
+/**
+ * @brief A running mean and variance
+ */
+typedef struct
+{
+        long n;
+        double mean;
+        double m2; /**< the sum of the squared differences from the mean */
+} welford_t;
+
+/**
+ * @brief The values below 2 * HIST_SUB have a bucket each, the larger ones
+ * share HIST_SUB buckets per power of 2
+ */
+typedef struct
+{
+        long count;
+        int max;
+        long buckets[HIST_BUCKETS];
+} histogram_t;
+
+void WelfordAdd(welford_t *w, double x);
+double WelfordStdDev(const welford_t *w);
+void HistogramAdd(histogram_t *h, int value);
+int HistogramPercentile(const histogram_t *h, double q);
+
+#endif /* _STATS_H */
@@ -0,0 +1,130 @@
+/**
+ * @file stats_page.h
+ * @brief The engine publishes its counters into a page of shared memory at
+ * the end of every tick, so a long run can be watched with schedtop.out.
+ * The page is written under a seqlock: the sequence is odd while it's being
+ * written, and a reader copies it until it gets the same even sequence
+ * before and after. The readers attach it read only and never hold up the
+ * engine. Both sched_engine.c and schedtop.c include it.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#ifndef _STATS_PAGE_H
+#define _STATS_PAGE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <sys/shm.h>
+#include "sched_engine.h"
+
+// Stats page shared memory key
+#define STATS_SHKEY 304
+
+/**
+ * @brief Layout of the stats page
+ */
+typedef struct
+{
+    unsigned seq;          /**< odd while the engine writes the page */
+    int pid;               /**< of the scheduler or the simulator */
+    int done;              /**< the run is over, nothing will change */
+    int ncpu;
+    int tick;
+    int processes;         /**< the processes of the trace */
+    int finished;
+    int dropped;           /**< their memory couldn't be allocated */
+    int ready;             /**< the PCBs waiting in all the run queues */
+    long switches;         /**< the PCBs started or resumed */
+    int memoryUsed;        /**< the bytes in the allocated blocks */
+    int largestFree;       /**< the largest free block of the buddy allocator */
+    int memorySize;
+    int running[MAX_CPUS]; /**< the id of the PCB on every CPU, -1 if it's idle */
+    int cpuReady[MAX_CPUS];
+    int idle[MAX_CPUS];    /**< the ticks every CPU was idle */
+    long cpuSwitches[MAX_CPUS];
+} stats_page_t;
+
+/*
+ * Remove the stats page if it was left by a run that's gone: nothing has it
+ * attached, or the process that created it is dead. 1 if it was removed.
+*/
+int removeStaleStatsPage()
+{
+    struct shmid_ds ds;
+    int shmid = shmget(STATS_SHKEY, 0, 0);
+    if (shmid == -1 || shmctl(shmid, IPC_STAT, &ds) == -1)
+        return 0;
+    if (ds.shm_nattch > 0 && (kill(ds.shm_cpid, 0) == 0 || errno != ESRCH))
+        return 0;
+    return shmctl(shmid, IPC_RMID, NULL) == 0;
+}
+
+/*
+ * Attach to the stats page. The engine creates it only if no other run has
+ * one, the page has a single writer, and runs without it if it can't. A page
+ * left by an interrupted run is removed first. The readers attach it read
+ * only. NULL if there's no page to attach.
+*/
+stats_page_t *attachStatsPage(int create, int *shmid)
+{
+    *shmid = shmget(STATS_SHKEY, sizeof(stats_page_t), create ? IPC_CREAT | IPC_EXCL | 0644 : 0444);
+    if (*shmid == -1 && create && errno == EEXIST && removeStaleStatsPage())
+        *shmid = shmget(STATS_SHKEY, sizeof(stats_page_t), IPC_CREAT | IPC_EXCL | 0644);
+    if (*shmid == -1)
+    {
+        if (create)
+            fprintf(stderr, "stats page: %s, schedtop.out can't watch this run\n",
+                    errno == EEXIST ? "another run has it" : strerror(errno));
+        else if (errno != ENOENT)
+            perror("Failed to get the stats page shared memory");
+        return NULL;
+    }
+
+    stats_page_t *page = (stats_page_t *) shmat(*shmid, (void *)0, create ? 0 : SHM_RDONLY);
+    if ((long)page == -1)
+    {
+        perror("Failed to attach the stats page shared memory");
+        if (create)
+            shmctl(*shmid, IPC_RMID, NULL);
+        return NULL;
+    }
+    return page;
+}
+
+/*
+ * Start writing the page, the readers retry until statsWriteEnd().
+*/
+void statsWriteBegin(stats_page_t *page)
+{
+    __atomic_store_n(&page->seq, page->seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+/*
+ * Publish what was written since statsWriteBegin().
+*/
+void statsWriteEnd(stats_page_t *page)
+{
+    __atomic_store_n(&page->seq, page->seq + 1, __ATOMIC_RELEASE);
+}
+
+/*
+ * Copy a consistent snapshot of the page.
+*/
+void statsRead(const stats_page_t *page, stats_page_t *copy)
+{
+    unsigned before, after;
+    do
+    {
+        before = __atomic_load_n(&page->seq, __ATOMIC_ACQUIRE);
+        memcpy(copy, (const void *)page, sizeof(stats_page_t));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        after = __atomic_load_n(&page->seq, __ATOMIC_RELAXED);
+    } while ((before & 1) || before != after);
+}
+
+#endif /* _STATS_PAGE_H */
@@ -1,6 +1,8 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
+#include "trace.h"
 #define null 0
 
 struct processData
@@ -12,17 +14,27 @@ struct processData
     int memSize;
 };
 
+void WriteBinaryProcesses(const char *fileName, const process_t *procs, int no);
+
 int main(int argc, char *argv[])
 {
-    FILE *pFile;
-    pFile = fopen("processes.txt", "w");
+    // -b writes the binary format to processes.bin instead of the text one
+    int binary = argc > 1 && strcmp(argv[1], "-b") == 0;
+    FILE *pFile = NULL;
+    process_t *procs = NULL;
     int no;
     struct processData pData;
     printf("Please enter the number of processes you want to generate: ");
     scanf("%d", &no);
     srand(time(null));
-    //fprintf(pFile,"%d\n",no);
-    fprintf(pFile, "#id arrival runtime priority memorysize\n");
+    if (binary)
+        procs = (process_t *)calloc(no, sizeof(process_t));
+    else
+    {
+        pFile = fopen("processes.txt", "w");
+        //fprintf(pFile,"%d\n",no);
+        fprintf(pFile, "#id arrival runtime priority memorysize\n");
+    }
     pData.arrivaltime = 0;
 
     int limit = 1024 / no;
@@ -36,7 +48,40 @@ int main(int argc, char *argv[])
         pData.priority = rand() % (11);
         pData.memSize = rand() % (limit);
 
-        fprintf(pFile, "%d\t%d\t%d\t%d\t%d\n", pData.id, pData.arrivaltime, pData.runningtime, pData.priority, pData.memSize);
+        if (binary)
+        {
+            procs[i - 1].id = procs[i - 1].task = pData.id;
+            procs[i - 1].arrivalTime = pData.arrivaltime;
+            procs[i - 1].runTime = pData.runningtime;
+            procs[i - 1].priority = pData.priority;
+            procs[i - 1].memSize = pData.memSize;
+        }
+        else
+            fprintf(pFile, "%d\t%d\t%d\t%d\t%d\n", pData.id, pData.arrivaltime, pData.runningtime, pData.priority, pData.memSize);
+    }
+
+    if (binary)
+    {
+        WriteBinaryProcesses("processes.bin", procs, no);
+        free(procs);
     }
-    fclose(pFile);
+    else
+        fclose(pFile);
+}
+
+/*
+ * Write the processes, in arrival order already, as a binary trace.
+*/
+void WriteBinaryProcesses(const char *fileName, const process_t *procs, int no)
+{
+    trace_header_t header;
+
+    InitTraceHeader(&header);
+    for (int i = 0; i < no; i++)
+        AddTraceRange(&header, &procs[i]);
+
+    FILE *fp = CreateBinaryTrace(fileName, &header);
+    for (int i = 0; i < no; i++)
+        WriteRecord(fp, &header, &procs[i]);
+    fclose(fp);
 }
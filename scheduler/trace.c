@@ -0,0 +1,531 @@
+/**
+ * @file trace.c
+ * @author Mohamed Hassanin
+ * @brief Reading the processes file shared by the process generator and the simulator.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include "trace.h"
+
+#define TRACE_COLUMNS 7
+#define TRACE_MIN_COLUMNS 5
+#define TRACE_DROP_BYTES (64 << 20) /**< the pages parsed are given back every this many bytes */
+
+process_t *ReleasePeriodicJobs(process_t *processes, size_t *processesNo);
+
+/**
+ * @brief Report a malformed line of the trace and exit
+ */
+static void TraceError(struct TraceReader *trace, const char *format, ...)
+{
+        va_list args;
+
+        fprintf(stderr, "trace: %s:%d: ", trace->fileName, trace->lineNo);
+        va_start(args, format);
+        vfprintf(stderr, format, args);
+        va_end(args);
+        fprintf(stderr, "\n");
+        exit(EXIT_FAILURE);
+}
+
+/**
+ * @brief Map the processes file, it's parsed where it is. A binary trace is
+ * recognized by its header.
+ */
+static void MapTrace(struct TraceReader *trace, const char *fileName)
+{
+        struct stat st;
+
+        int fd = open(fileName, O_RDONLY | O_CLOEXEC);
+        if (fd == -1 || fstat(fd, &st) == -1)
+        {
+                perror("processe generator: Error while opening the file.\n");
+                exit(EXIT_FAILURE);
+        }
+
+        trace->fileName = fileName;
+        trace->size = st.st_size;
+        trace->data = NULL;
+        if (trace->size > 0)
+        {
+                trace->data = mmap(NULL, trace->size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (trace->data == MAP_FAILED)
+                {
+                        perror("processe generator: Error while mapping the file.\n");
+                        exit(EXIT_FAILURE);
+                }
+                madvise(trace->data, trace->size, MADV_SEQUENTIAL);
+        }
+        close(fd);
+
+        trace->header = NULL;
+        if (CheckBinaryTrace(fileName, trace->data, trace->size))
+                trace->header = (const trace_header_t *)trace->data;
+        RewindTrace(trace);
+}
+
+static void UnmapTrace(struct TraceReader *trace)
+{
+        if (trace->data != NULL)
+                munmap(trace->data, trace->size);
+        trace->data = NULL;
+        trace->header = NULL;
+}
+
+/**
+ * @brief Go back to the first process of the trace
+ */
+void RewindTrace(struct TraceReader *trace)
+{
+        trace->pos = trace->header != NULL ? sizeof(trace_header_t) : 0;
+        trace->dropped = 0;
+        trace->lineNo = 0;
+        trace->taken = 0;
+        trace->peeked = 0;
+}
+
+/**
+ * @brief Convert the integer at p, it ends at the first character that isn't a digit
+ *
+ * @return const char* the end of the integer, NULL if there's none at p or it
+ * doesn't fit an int
+ */
+static const char *ParseInt(const char *p, const char *end, int *value)
+{
+        int negative = p < end && *p == '-';
+        if (negative)
+                p++;
+
+        const char *digits = p;
+        long number = 0;
+        while (p < end && (unsigned)(*p - '0') < 10)
+        {
+                number = number * 10 + (*p - '0');
+                if (number > INT_MAX)
+                        return NULL;
+                p++;
+        }
+        if (p == digits)
+                return NULL;
+
+        *value = negative ? -number : number;
+        return p;
+}
+
+/**
+ * @brief Parse the next process of the file. The columns are id, arrival,
+ * runtime, priority and memorysize, optionally followed by the relative
+ * deadline and the period, separated by tabs. The deadline of a periodic
+ * task is its period unless it has one. Comments and empty lines are
+ * skipped, any other line that doesn't fit ends the program with its line number.
+ * The next record of a binary trace is decoded instead.
+ *
+ * @param trace the mapped file
+ * @param proc the process to fill
+ * @return int 1 if there was a process, 0 at the end of the file
+ */
+static int ParseProcess(struct TraceReader *trace, process_t *proc)
+{
+        const char *end = trace->data + trace->size;
+
+        // a streamed trace only keeps the pages it hasn't parsed yet
+        if (trace->pos - trace->dropped >= TRACE_DROP_BYTES)
+        {
+                size_t upto = trace->pos & ~((size_t)sysconf(_SC_PAGESIZE) - 1);
+                madvise(trace->data + trace->dropped, upto - trace->dropped, MADV_DONTNEED);
+                trace->dropped = upto;
+        }
+
+        // a binary record is a process, the lines count the records. They're
+        // bounded by the count of the header, a record of a trace whose
+        // columns never change takes no bytes.
+        if (trace->header != NULL)
+        {
+                if ((uint64_t)trace->lineNo >= trace->header->count)
+                        return 0;
+                ReadRecord(trace->header, trace->data + trace->pos, proc);
+                trace->pos += trace->header->recordSize;
+                trace->lineNo++;
+                return 1;
+        }
+
+        while (trace->pos < trace->size)
+        {
+                const char *line = trace->data + trace->pos;
+                // glibc looks for the newline a vector at a time
+                const char *eol = memchr(line, '\n', end - line);
+                if (eol == NULL)
+                        eol = end;
+                trace->pos = eol - trace->data + 1;
+                trace->lineNo++;
+
+                while (eol > line && (eol[-1] == '\r' || eol[-1] == '\t' || eol[-1] == ' '))
+                        eol--;
+                if (line == eol || line[0] == '#')
+                        continue;
+
+                // the deadline and the period are optional
+                int numbers[TRACE_COLUMNS] = {0}, columns = 0;
+                const char *p = line;
+                while (1)
+                {
+                        if (columns == TRACE_COLUMNS)
+                                TraceError(trace, "more than %d columns", TRACE_COLUMNS);
+                        p = ParseInt(p, eol, &numbers[columns]);
+                        if (p == NULL)
+                                TraceError(trace, "column %d isn't an integer", columns + 1);
+                        columns++;
+
+                        if (p == eol)
+                                break;
+                        if (*p != '\t')
+                                TraceError(trace, "column %d isn't followed by a tab", columns);
+                        p++;
+                }
+                if (columns < TRACE_MIN_COLUMNS)
+                        TraceError(trace, "%d columns, at least %d expected", columns, TRACE_MIN_COLUMNS);
+
+                proc->id = numbers[0];
+                proc->arrivalTime = numbers[1];
+                proc->runTime = numbers[2];
+                proc->priority = numbers[3];
+                proc->arrived = 0;
+                proc->memSize = numbers[4];
+                // a periodic task without a deadline has to finish a job by the next one
+                proc->deadline = numbers[5] == 0 && numbers[6] > 0 ? numbers[6] : numbers[5];
+                proc->period = numbers[6];
+                proc->task = numbers[0];
+                return 1;
+        }
+        return 0;
+}
+
+/**
+ * @brief Parse the whole file once to count its processes
+ *
+ * @param sorted set to 1 if they're sorted by arrival
+ * @param periodic set to 1 if one of them is a periodic task
+ */
+static int CountProcesses(struct TraceReader *trace, int *sorted, int *periodic)
+{
+        int count = 0, lastArrival = 0;
+        process_t proc;
+
+        *sorted = 1;
+        *periodic = 0;
+        RewindTrace(trace);
+        while (ParseProcess(trace, &proc))
+        {
+                if (count > 0 && proc.arrivalTime < lastArrival)
+                        *sorted = 0;
+                *periodic |= proc.period > 0;
+                lastArrival = proc.arrivalTime;
+                count++;
+        }
+        RewindTrace(trace);
+        return count;
+}
+
+/**
+ * @brief Parse every process of the file in an array and release the periodic jobs
+ */
+static process_t *LoadProcesses(struct TraceReader *trace, int count, int *numberOfProcesses)
+{
+        size_t processesNo = 0;
+        process_t *processes = (process_t *)malloc(sizeof(process_t) * (count > 0 ? count : 1));
+
+        while (processesNo < (size_t)count && ParseProcess(trace, &processes[processesNo]))
+                processesNo++;
+        processes = ReleasePeriodicJobs(processes, &processesNo);
+
+        *numberOfProcesses = processesNo;
+        return processes;
+}
+
+/**
+ * @brief Create a Processes objects array after parsing the processes file,
+ * see ParseProcess(). Every periodic task is replaced by the jobs it releases,
+ * see ReleasePeriodicJobs().
+ * 
+ * @param fileName the name of the processes file
+ * @param numberOfProcesses the number of processes in the array.
+ * @return process* array of processes
+ */
+process_t *CreateProcesses(const char *fileName, int *numberOfProcesses)
+{
+        struct TraceReader trace;
+        int sorted, periodic;
+
+        MapTrace(&trace, fileName);
+        int count = CountProcesses(&trace, &sorted, &periodic);
+        process_t *processes = LoadProcesses(&trace, count, numberOfProcesses);
+
+        UnmapTrace(&trace);
+        return processes;
+}
+
+/**
+ * @brief Open a trace to read its processes in arrival order. A binary trace
+ * is read from its mapping as it is. A text file is mapped and parsed once to
+ * count the processes. If it's sorted by arrival
+ * and has no periodic task it's then parsed as the processes are taken, the
+ * pages already read can be dropped so it doesn't have to fit in memory. Any
+ * other file is loaded, its periodic jobs released and checked, see
+ * CheckSchedulability(), and sorted.
+ *
+ * @param fileName the name of the processes file
+ * @param cpus the number of CPUs the deadlines are checked for
+ * @return struct TraceReader* the reader, see PeekProcess() and SkipProcess()
+ */
+struct TraceReader *OpenTrace(const char *fileName, int cpus)
+{
+        struct TraceReader *trace = (struct TraceReader *)calloc(1, sizeof(struct TraceReader));
+        int sorted, periodic;
+
+        MapTrace(trace, fileName);
+
+        // a binary trace is sorted and its jobs were released, it's read right away
+        if (trace->header != NULL)
+        {
+                trace->count = trace->header->count;
+                trace->tasks = trace->header->tasks;
+                trace->density = trace->header->density;
+                ReportDensity(trace->tasks, trace->density, cpus);
+                return trace;
+        }
+
+        trace->count = CountProcesses(trace, &sorted, &periodic);
+        if (sorted && !periodic)
+                return trace;
+
+        trace->processes = LoadProcesses(trace, trace->count, &trace->count);
+        UnmapTrace(trace);
+        trace->density = TaskDensity(trace->processes, trace->count, &trace->tasks);
+        ReportDensity(trace->tasks, trace->density, cpus);
+        SortByArrival(trace->processes, trace->count);
+        return trace;
+}
+
+/**
+ * @return const process_t* the next process in arrival order, NULL once
+ * they've all been taken
+ */
+const process_t *PeekProcess(struct TraceReader *trace)
+{
+        if (trace->taken == trace->count)
+                return NULL;
+        if (trace->processes != NULL)
+                return &trace->processes[trace->taken];
+
+        // parse the next process unless it's been parsed already
+        if (!trace->peeked)
+        {
+                if (!ParseProcess(trace, &trace->next))
+                        TraceError(trace, "the file changed while it was read");
+                trace->peeked = 1;
+        }
+        return &trace->next;
+}
+
+/**
+ * @brief Take the next process, the one PeekProcess() returns
+ */
+void SkipProcess(struct TraceReader *trace)
+{
+        PeekProcess(trace);
+        trace->taken++;
+        trace->peeked = 0;
+}
+
+void CloseTrace(struct TraceReader *trace)
+{
+        UnmapTrace(trace);
+        free(trace->processes);
+        free(trace);
+}
+
+int GCD(int a, int b)
+{
+        while (b != 0)
+        {
+                int r = a % b;
+                a = b;
+                b = r;
+        }
+        return a;
+}
+
+/**
+ * @brief Replace every periodic task by the jobs it releases in one hyperperiod,
+ * the least common multiple of the periods. The first job keeps the id of the
+ * task, the others get the ids after the last one of the file.
+ *
+ * @param processes the processes of the file
+ * @param processesNo the number of processes, updated to the number of jobs
+ * @return process_t* the jobs
+ */
+process_t *ReleasePeriodicJobs(process_t *processes, size_t *processesNo)
+{
+        long hyperperiod = 1;
+        size_t jobs = *processesNo;
+        int nextId = 0;
+
+        for (size_t i = 0; i < *processesNo; i++)
+        {
+                if (processes[i].id > nextId)
+                        nextId = processes[i].id;
+                if (processes[i].period > 0)
+                {
+                        hyperperiod = hyperperiod / GCD(hyperperiod, processes[i].period) * processes[i].period;
+                        if (hyperperiod > TRACE_MAX_HYPERPERIOD)
+                                hyperperiod = TRACE_MAX_HYPERPERIOD;
+                }
+        }
+
+        for (size_t i = 0; i < *processesNo; i++)
+        {
+                if (processes[i].period > 0)
+                        jobs += (hyperperiod - 1) / processes[i].period;
+        }
+        if (jobs == *processesNo)
+                return processes;
+
+        processes = (process_t *)realloc(processes, sizeof(process_t) * jobs);
+        size_t job = *processesNo;
+        for (size_t i = 0; i < *processesNo; i++)
+        {
+                for (long release = processes[i].period; processes[i].period > 0 && release < hyperperiod; release += processes[i].period)
+                {
+                        processes[job] = processes[i];
+                        processes[job].id = ++nextId;
+                        processes[job].arrivalTime += release;
+                        job++;
+                }
+        }
+
+        *processesNo = jobs;
+        return processes;
+}
+
+/**
+ * @brief Check whether EDF can meet the deadlines of the periodic tasks. Their
+ * density, the sum of runtime / min(deadline, period), is their utilization
+ * when the deadlines are the periods. One CPU meets every deadline if it's at
+ * most 1. Above the number of CPUs the test fails, but with deadlines shorter
+ * than the periods the deadlines may still be met.
+ *
+ * @param processes the jobs from CreateProcesses()
+ * @param numberOfProcesses the number of jobs
+ * @param cpus the number of CPUs
+ * @return int 1 if the deadlines can be met, 0 if some may be missed
+ */
+int CheckSchedulability(const process_t *processes, int numberOfProcesses, int cpus)
+{
+        int tasks;
+        double density = TaskDensity(processes, numberOfProcesses, &tasks);
+
+        return ReportDensity(tasks, density, cpus);
+}
+
+/**
+ * @brief The density of the periodic tasks, see CheckSchedulability()
+ *
+ * @param tasks set to the number of periodic tasks
+ */
+double TaskDensity(const process_t *processes, int numberOfProcesses, int *tasks)
+{
+        double density = 0;
+
+        *tasks = 0;
+        for (int i = 0; i < numberOfProcesses; i++)
+        {
+                // the first job stands for its task
+                if (processes[i].period == 0 || processes[i].id != processes[i].task)
+                        continue;
+
+                int window = processes[i].period;
+                if (processes[i].deadline > 0 && processes[i].deadline < window)
+                        window = processes[i].deadline;
+                density += (double)processes[i].runTime / window;
+                (*tasks)++;
+        }
+        return density;
+}
+
+/**
+ * @brief Print whether the periodic tasks meet their deadlines on the CPUs,
+ * see CheckSchedulability()
+ */
+int ReportDensity(int tasks, double density, int cpus)
+{
+        if (tasks == 0)
+                return 1;
+
+        if (density > cpus)
+        {
+                printf("trace: the density of the %d periodic tasks is %.3f, %d cpu(s) may miss deadlines\n", tasks, density, cpus);
+                return 0;
+        }
+        if (cpus == 1)
+                printf("trace: the density of the %d periodic tasks is %.3f, EDF meets every deadline\n", tasks, density);
+        else
+                printf("trace: the density of the %d periodic tasks is %.3f, %d cpus may meet every deadline\n", tasks, density, cpus);
+        return 1;
+}
+
+/**
+ * @brief Stable sort of the processes by arrival time (bottom up merge sort).
+ * Traces are usually sorted already, then it's a single pass.
+ *
+ * @param processes the processes array
+ * @param numberOfProcesses the number of processes in the array
+ */
+void SortByArrival(process_t *processes, int numberOfProcesses)
+{
+        int sorted = 1;
+        for (int i = 1; i < numberOfProcesses && sorted; i++)
+                sorted = processes[i - 1].arrivalTime <= processes[i].arrivalTime;
+        if (sorted)
+                return;
+
+        process_t *from = processes, *to = (process_t *)malloc(sizeof(process_t) * numberOfProcesses);
+        for (int width = 1; width < numberOfProcesses; width *= 2)
+        {
+                for (int lo = 0; lo < numberOfProcesses; lo += 2 * width)
+                {
+                        int mid = lo + width < numberOfProcesses ? lo + width : numberOfProcesses;
+                        int hi = lo + 2 * width < numberOfProcesses ? lo + 2 * width : numberOfProcesses;
+                        int i = lo, j = mid, k = lo;
+
+                        while (i < mid && j < hi)
+                                to[k++] = from[j].arrivalTime < from[i].arrivalTime ? from[j++] : from[i++];
+                        while (i < mid)
+                                to[k++] = from[i++];
+                        while (j < hi)
+                                to[k++] = from[j++];
+                }
+
+                process_t *tmp = from;
+                from = to;
+                to = tmp;
+        }
+
+        if (from != processes)
+        {
+                for (int i = 0; i < numberOfProcesses; i++)
+                        processes[i] = from[i];
+                to = from;
+        }
+        free(to);
+}
@@ -0,0 +1,96 @@
+/**
+ * @file trace.h
+ * @brief Reading the processes file shared by the process generator and the simulator.
+ * It's either text, a process per line, or the binary format of trace_binary.c.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+#ifndef _TRACE_H
+#define _TRACE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include "process_generator.h"
+
+#define TRACE_MAX_HYPERPERIOD 1000000 /**< the periodic tasks release their jobs for at most this long */
+
+#define TRACE_MAGIC "SCHDTRC\n" /**< the first 8 bytes of a binary trace */
+#define TRACE_VERSION 1
+
+/**
+ * @brief The columns of a binary record, in the order they're stored
+ */
+enum TraceField
+{
+        TRACE_ID,
+        TRACE_ARRIVAL,
+        TRACE_RUNTIME,
+        TRACE_PRIORITY,
+        TRACE_MEMSIZE,
+        TRACE_DEADLINE,
+        TRACE_FIELDS
+};
+
+/**
+ * @brief The header of a binary trace, the records follow it sorted by
+ * arrival. A column is stored as its distance from the min of its range, in
+ * as many little endian bytes as the range needs, so a column that never
+ * changes takes no room at all.
+ */
+typedef struct
+{
+        char magic[8];                 /**< TRACE_MAGIC */
+        uint32_t version;              /**< TRACE_VERSION */
+        uint32_t recordSize;           /**< the sum of the widths */
+        uint64_t count;                /**< the number of records */
+        int32_t min[TRACE_FIELDS];     /**< the key ranges of the columns */
+        int32_t max[TRACE_FIELDS];
+        uint8_t width[TRACE_FIELDS];   /**< the bytes a column takes, 0 to 4 */
+        uint8_t reserved[2];
+        uint32_t tasks;                /**< the periodic tasks the jobs were released by */
+        uint32_t flags;                /**< 0 in this version */
+        double density;                /**< their density, see CheckSchedulability() */
+} trace_header_t;
+
+/**
+ * @brief The processes of a trace in arrival order, the ones that arrive in
+ * the same tick in file order. See OpenTrace().
+ */
+struct TraceReader
+{
+        const char *fileName;
+        char *data;           /**< the file mapped read only */
+        const trace_header_t *header; /**< NULL for a text trace */
+        size_t size;
+        size_t pos;           /**< the offset of the next line to parse */
+        size_t dropped;       /**< the pages before it were given back */
+        int lineNo;           /**< the number of the last line parsed, for the errors */
+        process_t *processes; /**< the loaded trace, NULL if it's streamed */
+        int count;            /**< the number of processes of the trace */
+        int taken;            /**< the processes taken so far */
+        process_t next;       /**< the next process of a streamed trace */
+        int peeked;           /**< 1 if next was read already */
+        int tasks;            /**< the periodic tasks of the trace */
+        double density;       /**< and their density */
+};
+
+process_t *CreateProcesses(const char *fileName, int *numberOfProcesses);
+int CheckSchedulability(const process_t *processes, int numberOfProcesses, int cpus);
+double TaskDensity(const process_t *processes, int numberOfProcesses, int *tasks);
+int ReportDensity(int tasks, double density, int cpus);
+void SortByArrival(process_t *processes, int numberOfProcesses);
+
+struct TraceReader *OpenTrace(const char *fileName, int cpus);
+const process_t *PeekProcess(struct TraceReader *trace);
+void SkipProcess(struct TraceReader *trace);
+void RewindTrace(struct TraceReader *trace);
+void CloseTrace(struct TraceReader *trace);
+
+void InitTraceHeader(trace_header_t *header);
+void AddTraceRange(trace_header_t *header, const process_t *proc);
+FILE *CreateBinaryTrace(const char *fileName, trace_header_t *header);
+void WriteRecord(FILE *fp, const trace_header_t *header, const process_t *proc);
+int CheckBinaryTrace(const char *fileName, const char *data, size_t size);
+void ReadRecord(const trace_header_t *header, const char *record, process_t *proc);
+
+#endif /* _TRACE_H */
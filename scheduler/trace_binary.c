@@ -0,0 +1,187 @@
+/**
+ * @file trace_binary.c
+ * @brief The binary trace format: a trace_header_t, then one record per
+ * process sorted by arrival. It's mapped and read where it is, there's
+ * nothing to parse or sort, and every column only takes the bytes its range
+ * needs. trace_convert.out converts a text trace to it and back.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "trace.h"
+
+/**
+ * @brief The column field of the process
+ */
+static int32_t FieldOf(const process_t *proc, int field)
+{
+        switch (field)
+        {
+        case TRACE_ID:
+                return proc->id;
+        case TRACE_ARRIVAL:
+                return proc->arrivalTime;
+        case TRACE_RUNTIME:
+                return proc->runTime;
+        case TRACE_PRIORITY:
+                return proc->priority;
+        case TRACE_MEMSIZE:
+                return proc->memSize;
+        default:
+                return proc->deadline;
+        }
+}
+
+/**
+ * @brief Start a header with empty ranges, see AddTraceRange()
+ */
+void InitTraceHeader(trace_header_t *header)
+{
+        memset(header, 0, sizeof(trace_header_t));
+        memcpy(header->magic, TRACE_MAGIC, sizeof(header->magic));
+        header->version = TRACE_VERSION;
+        for (int field = 0; field < TRACE_FIELDS; field++)
+        {
+                header->min[field] = INT32_MAX;
+                header->max[field] = INT32_MIN;
+        }
+}
+
+/**
+ * @brief Count the process and widen the ranges of the header to it, every
+ * process of the trace has to be added before the first record is written
+ */
+void AddTraceRange(trace_header_t *header, const process_t *proc)
+{
+        header->count++;
+        for (int field = 0; field < TRACE_FIELDS; field++)
+        {
+                int32_t value = FieldOf(proc, field);
+                if (value < header->min[field])
+                        header->min[field] = value;
+                if (value > header->max[field])
+                        header->max[field] = value;
+        }
+}
+
+/**
+ * @brief Create a binary trace and write its header. The widths of the
+ * columns follow from the ranges of the header, see AddTraceRange().
+ *
+ * @param fileName the name of the binary trace
+ * @param header the header, its widths and record size are filled in
+ * @return FILE* the file to write the records to, see WriteRecord()
+ */
+FILE *CreateBinaryTrace(const char *fileName, trace_header_t *header)
+{
+        header->recordSize = 0;
+        for (int field = 0; field < TRACE_FIELDS; field++)
+        {
+                // an empty trace has no range
+                if (header->count == 0)
+                        header->min[field] = header->max[field] = 0;
+
+                uint32_t range = (uint32_t)header->max[field] - (uint32_t)header->min[field];
+                int width = 0;
+                while (width < 4 && (range >> (8 * width)) != 0)
+                        width++;
+
+                header->width[field] = width;
+                header->recordSize += width;
+        }
+
+        FILE *fp = fopen(fileName, "wb");
+        if (fp == NULL || fwrite(header, sizeof(trace_header_t), 1, fp) != 1)
+        {
+                perror("trace: couldn't create the binary trace");
+                exit(EXIT_FAILURE);
+        }
+        return fp;
+}
+
+/**
+ * @brief Append the record of the process, the processes have to be written
+ * in arrival order
+ */
+void WriteRecord(FILE *fp, const trace_header_t *header, const process_t *proc)
+{
+        unsigned char record[4 * TRACE_FIELDS];
+        int size = 0;
+
+        for (int field = 0; field < TRACE_FIELDS; field++)
+        {
+                uint32_t value = (uint32_t)FieldOf(proc, field) - (uint32_t)header->min[field];
+                for (int byte = 0; byte < header->width[field]; byte++)
+                        record[size++] = value >> (8 * byte);
+        }
+
+        if (fwrite(record, size, 1, fp) != 1 && size > 0)
+        {
+                perror("trace: couldn't write the binary trace");
+                exit(EXIT_FAILURE);
+        }
+}
+
+/**
+ * @brief Check whether the mapped file is a binary trace that can be read
+ *
+ * @return int 1 if it's a binary trace, 0 if it's text. A binary trace of
+ * another version or with the wrong size ends the program.
+ */
+int CheckBinaryTrace(const char *fileName, const char *data, size_t size)
+{
+        const trace_header_t *header = (const trace_header_t *)data;
+
+        if (size < sizeof(header->magic) || memcmp(data, TRACE_MAGIC, sizeof(header->magic)) != 0)
+                return 0;
+
+        if (size < sizeof(trace_header_t) || header->version != TRACE_VERSION)
+        {
+                fprintf(stderr, "trace: %s: binary trace version %u, this build reads version %d\n",
+                        fileName, size < sizeof(trace_header_t) ? 0 : header->version, TRACE_VERSION);
+                exit(EXIT_FAILURE);
+        }
+
+        uint32_t recordSize = 0;
+        for (int field = 0; field < TRACE_FIELDS; field++)
+                recordSize += header->width[field];
+        if (recordSize != header->recordSize || header->count > INT_MAX ||
+            size != sizeof(trace_header_t) + header->count * header->recordSize)
+        {
+                fprintf(stderr, "trace: %s: truncated or corrupt binary trace\n", fileName);
+                exit(EXIT_FAILURE);
+        }
+        return 1;
+}
+
+/**
+ * @brief Decode a record into a process. Its jobs were released already, so
+ * the process isn't periodic.
+ */
+void ReadRecord(const trace_header_t *header, const char *record, process_t *proc)
+{
+        const unsigned char *byte = (const unsigned char *)record;
+        int32_t values[TRACE_FIELDS];
+
+        for (int field = 0; field < TRACE_FIELDS; field++)
+        {
+                uint32_t value = 0;
+                for (int i = 0; i < header->width[field]; i++)
+                        value |= (uint32_t)*byte++ << (8 * i);
+                values[field] = (int32_t)(value + (uint32_t)header->min[field]);
+        }
+
+        proc->id = values[TRACE_ID];
+        proc->arrivalTime = values[TRACE_ARRIVAL];
+        proc->runTime = values[TRACE_RUNTIME];
+        proc->priority = values[TRACE_PRIORITY];
+        proc->arrived = 0;
+        proc->memSize = values[TRACE_MEMSIZE];
+        proc->deadline = values[TRACE_DEADLINE];
+        proc->period = 0;
+        proc->task = values[TRACE_ID];
+}
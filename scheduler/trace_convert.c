@@ -0,0 +1,101 @@
+/**
+ * @file trace_convert.c
+ * @brief Convert a trace to the binary format of trace_binary.c, or back to
+ * text with -t. The periodic tasks of a text trace are released into their
+ * jobs, so they come back as jobs that run once.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "trace.h"
+
+void WriteBinary(struct TraceReader *trace, const char *fileName);
+void WriteText(struct TraceReader *trace, const char *fileName);
+
+int main(int argc, char *argv[])
+{
+        int toText = 0, opt;
+
+        // trace_convert.out [-t] input output
+        while ((opt = getopt(argc, argv, "t")) != -1)
+        {
+                if (opt == 't')
+                        toText = 1;
+                else
+                        break;
+        }
+        if (argc - optind != 2)
+        {
+                fprintf(stderr, "usage: %s [-t] input output, -t converts a binary trace back to text\n", argv[0]);
+                exit(EXIT_FAILURE);
+        }
+
+        struct TraceReader *trace = OpenTrace(argv[optind], 1);
+        if (toText)
+                WriteText(trace, argv[optind + 1]);
+        else
+                WriteBinary(trace, argv[optind + 1]);
+
+        struct stat in, out;
+        stat(argv[optind], &in);
+        stat(argv[optind + 1], &out);
+        printf("trace_convert: %d processes, %lld bytes to %lld bytes (%.0f%%)\n", trace->count,
+               (long long)in.st_size, (long long)out.st_size, in.st_size ? 100.0 * out.st_size / in.st_size : 0.0);
+
+        CloseTrace(trace);
+}
+
+/**
+ * @brief Write the trace in the binary format, once to get the ranges of the
+ * columns and once for the records
+ */
+void WriteBinary(struct TraceReader *trace, const char *fileName)
+{
+        trace_header_t header;
+        const process_t *proc;
+
+        InitTraceHeader(&header);
+        for (; (proc = PeekProcess(trace)) != NULL; SkipProcess(trace))
+                AddTraceRange(&header, proc);
+        header.tasks = trace->tasks;
+        header.density = trace->density;
+
+        FILE *fp = CreateBinaryTrace(fileName, &header);
+        RewindTrace(trace);
+        for (; (proc = PeekProcess(trace)) != NULL; SkipProcess(trace))
+                WriteRecord(fp, &header, proc);
+        fclose(fp);
+
+        printf("trace_convert: %u bytes a record, arrivals %d to %d\n", header.recordSize,
+               header.min[TRACE_ARRIVAL], header.max[TRACE_ARRIVAL]);
+}
+
+/**
+ * @brief Write the trace as text in arrival order, the deadline column only
+ * for the processes that have one
+ */
+void WriteText(struct TraceReader *trace, const char *fileName)
+{
+        FILE *fp = fopen(fileName, "w");
+        const process_t *proc;
+
+        if (fp == NULL)
+        {
+                perror("trace_convert: couldn't create the text trace");
+                exit(EXIT_FAILURE);
+        }
+
+        fprintf(fp, "#id arrival runtime priority memorysize deadline\n");
+        for (; (proc = PeekProcess(trace)) != NULL; SkipProcess(trace))
+        {
+                fprintf(fp, "%d\t%d\t%d\t%d\t%d", proc->id, proc->arrivalTime, proc->runTime, proc->priority, proc->memSize);
+                if (proc->deadline != 0)
+                        fprintf(fp, "\t%d", proc->deadline);
+                fprintf(fp, "\n");
+        }
+        fclose(fp);
+}
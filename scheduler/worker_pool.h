@@ -0,0 +1,101 @@
+/**
+ * @file worker_pool.h
+ * @brief The process.out workers the scheduler runs its PCBs on. A worker is
+ * forked once and sleeps on the control word of its slot until the scheduler
+ * hands it a PCB, runs it to completion and goes back to sleep, so most
+ * dispatches are a futex wake instead of a fork and an exec.
+ * The slot is the control block of the PCB while the worker runs it: the
+ * scheduler stops and resumes it by writing the control word and waking the
+ * worker, and reads the remaining time the worker counts down.
+ * Both the scheduler and process.out include it after headers.h.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#ifndef _WORKER_POOL_H
+#define _WORKER_POOL_H
+
+// Worker pool shared memory key
+#define WORKER_SHKEY 302
+
+#define WORKER_SLOTS 1024 /**< at most this many PCBs are started and not finished, one byte of memory each */
+#define WORKER_POOL_DEFAULT 16 /**< the workers forked before the first dispatch */
+
+// the control word of a slot
+#define WORKER_IDLE 0    /**< waiting for a PCB, set by the worker */
+#define WORKER_RUNNING 1 /**< running a PCB, set by the scheduler */
+#define WORKER_STOPPED 2 /**< its PCB was preempted, set by the scheduler */
+#define WORKER_EXIT 3    /**< the scheduler is done, set by the scheduler */
+
+// how the worker of a dispatch got there
+#define DISPATCH_FORKED 0 /**< forked for it, no worker was idle */
+#define DISPATCH_WOKEN 1  /**< an idle worker was woken up */
+#define DISPATCH_PATHS 2
+
+#define DISPATCH_BUCKETS 32 /**< bucket b counts the latencies below 2^b us */
+
+typedef struct
+{
+    int ctl;              /**< one of the WORKER_ states, the worker sleeps on it while it's idle or stopped */
+    int cpu;              /**< the CPU the PCB runs on, its worker arrives at its tick barrier */
+    int remaining;        /**< the remaining time of the PCB, the worker counts it down */
+    int since;            /**< the tick the PCB was last started or resumed at, the worker counts from there */
+    int path;             /**< DISPATCH_FORKED or DISPATCH_WOKEN */
+    long long dispatchNs; /**< CLOCK_MONOTONIC ns the scheduler decided to start the PCB at */
+} worker_slot_t;
+
+/**
+ * @brief Layout of the worker pool shared memory. The latencies run from the
+ * scheduler's decision to start a PCB to its worker picking it up.
+ */
+typedef struct
+{
+    worker_slot_t slots[WORKER_SLOTS];
+    long long dispatches[DISPATCH_PATHS];
+    long long latencyNs[DISPATCH_PATHS];    /**< the sum, for the average */
+    long long maxLatencyNs[DISPATCH_PATHS];
+    long long latencies[DISPATCH_PATHS][DISPATCH_BUCKETS];
+} worker_pool_t;
+
+/*
+ * Attach to the worker pool shared memory, the scheduler creates it.
+*/
+worker_pool_t *attachWorkerPool(int create, int *shmid)
+{
+    *shmid = shmget(WORKER_SHKEY, sizeof(worker_pool_t), create ? IPC_CREAT | 0644 : 0644);
+    if (*shmid == -1)
+    {
+        perror("Failed to get the worker pool shared memory");
+        exit(EXIT_FAILURE);
+    }
+
+    worker_pool_t *pool = (worker_pool_t *) shmat(*shmid, (void *)0, 0);
+    if ((long)pool == -1)
+    {
+        perror("Failed to attach the worker pool shared memory");
+        exit(EXIT_FAILURE);
+    }
+    return pool;
+}
+
+/*
+ * Count a dispatch that took ns from the decision to the worker picking it up.
+ * Only the worker of the dispatch writes, the scheduler reads at the end.
+*/
+void recordDispatch(worker_pool_t *pool, int path, long long ns)
+{
+    int bucket = 0;
+    while (bucket < DISPATCH_BUCKETS - 1 && (1LL << bucket) * 1000 <= ns)
+        bucket++;
+
+    __atomic_add_fetch(&pool->dispatches[path], 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&pool->latencyNs[path], ns, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&pool->latencies[path][bucket], 1, __ATOMIC_RELAXED);
+
+    long long max = __atomic_load_n(&pool->maxLatencyNs[path], __ATOMIC_RELAXED);
+    while (ns > max && !__atomic_compare_exchange_n(&pool->maxLatencyNs[path], &max, ns, 0,
+                                                    __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        ;
+}
+
+#endif /* _WORKER_POOL_H */
@@ -0,0 +1,340 @@
+/**
+ * @file workload_gen.c
+ * @brief Generate a synthetic trace from distributions: Poisson or bursty
+ * arrivals, heavy tailed runtimes, bimodal memory sizes and a priority that
+ * follows the runtime. The same seed gives the same trace, and the processes
+ * are streamed to the file, so a trace of millions of processes takes no memory.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include "buddy.h"
+#include "trace.h"
+
+#define WORKLOAD_MAX_PARAMS 3
+#define WORKLOAD_RUNTIME_CAP 100000 /**< the default cap of a heavy tailed runtime */
+
+/**
+ * @brief A distribution given as name:p1,p2,p3 on the command line
+ */
+struct Distribution
+{
+        char name[16];
+        double params[WORKLOAD_MAX_PARAMS];
+        int nparams;
+};
+
+/**
+ * @brief The options of the trace and the state of its generation
+ */
+struct Workload
+{
+        long count;
+        unsigned long long seed;
+        struct Distribution arrival, runtime, memory;
+        double correlation; /**< of the priority with the runtime, -1 to 1 */
+        int maxPriority;
+        int runtimeCap;
+
+        unsigned long long state; /**< splitmix64 */
+        double time;              /**< the arrival of the last process, before it's rounded down */
+        int burstLeft;            /**< the processes left in the current burst */
+};
+
+/**
+ * @brief A distribution that can be asked for and how many parameters it takes
+ */
+struct DistributionKind
+{
+        const char *name;
+        int nparams;
+};
+
+const struct DistributionKind arrivalKinds[] = {{"poisson", 1}, {"bursty", 2}, {"uniform", 1}, {NULL, 0}};
+const struct DistributionKind runtimeKinds[] = {{"pareto", 2}, {"lognormal", 2}, {"uniform", 2}, {NULL, 0}};
+const struct DistributionKind memoryKinds[] = {{"bimodal", 3}, {"uniform", 2}, {NULL, 0}};
+
+void ParseDistribution(const char *spec, struct Distribution *dist);
+void CheckDistribution(const char *option, const struct Distribution *dist, const struct DistributionKind *kinds);
+void Generate(struct Workload *work, process_t *proc, long id);
+void Usage(const char *program);
+
+int main(int argc, char *argv[])
+{
+        struct Workload work = {
+                .count = 0,
+                .seed = 1,
+                .correlation = 0,
+                .maxPriority = 10,
+                .runtimeCap = WORKLOAD_RUNTIME_CAP,
+        };
+        const char *fileName = NULL;
+        int binary = 0, opt;
+
+        ParseDistribution("poisson:0.5", &work.arrival);
+        ParseDistribution("pareto:2,1.5", &work.runtime);
+        ParseDistribution("bimodal:32,512,0.1", &work.memory);
+
+        while ((opt = getopt(argc, argv, "n:s:a:r:m:c:p:R:o:b")) != -1)
+        {
+                if (opt == 'n')
+                        work.count = atol(optarg);
+                else if (opt == 's')
+                        work.seed = strtoull(optarg, NULL, 10);
+                else if (opt == 'a')
+                        ParseDistribution(optarg, &work.arrival);
+                else if (opt == 'r')
+                        ParseDistribution(optarg, &work.runtime);
+                else if (opt == 'm')
+                        ParseDistribution(optarg, &work.memory);
+                else if (opt == 'c')
+                        work.correlation = atof(optarg);
+                else if (opt == 'p')
+                        work.maxPriority = atoi(optarg);
+                else if (opt == 'R')
+                        work.runtimeCap = atoi(optarg);
+                else if (opt == 'o')
+                        fileName = optarg;
+                else if (opt == 'b')
+                        binary = 1;
+                else
+                        Usage(argv[0]);
+        }
+        if (work.count <= 0 || work.count > INT32_MAX || work.correlation < -1 || work.correlation > 1 ||
+            work.maxPriority < 0 || work.runtimeCap < 1)
+                Usage(argv[0]);
+        if (fileName == NULL)
+                fileName = binary ? "processes.bin" : "processes.txt";
+
+        CheckDistribution("-a", &work.arrival, arrivalKinds);
+        CheckDistribution("-r", &work.runtime, runtimeKinds);
+        CheckDistribution("-m", &work.memory, memoryKinds);
+        if ((strcmp(work.arrival.name, "uniform") != 0 && work.arrival.params[0] <= 0) ||
+            (strcmp(work.runtime.name, "pareto") == 0 && (work.runtime.params[0] <= 0 || work.runtime.params[1] <= 0)))
+                Usage(argv[0]);
+
+        process_t proc;
+        long long totalRuntime = 0;
+        int maxRuntime = 0;
+        long large = 0;
+
+        if (binary)
+        {
+                // the ranges come first, the same seed generates the same processes twice
+                trace_header_t header;
+                InitTraceHeader(&header);
+                work.state = work.seed, work.time = 0, work.burstLeft = 0;
+                for (long id = 1; id <= work.count; id++)
+                {
+                        Generate(&work, &proc, id);
+                        AddTraceRange(&header, &proc);
+                }
+
+                FILE *fp = CreateBinaryTrace(fileName, &header);
+                work.state = work.seed, work.time = 0, work.burstLeft = 0;
+                for (long id = 1; id <= work.count; id++)
+                {
+                        Generate(&work, &proc, id);
+                        WriteRecord(fp, &header, &proc);
+                        totalRuntime += proc.runTime;
+                        maxRuntime = proc.runTime > maxRuntime ? proc.runTime : maxRuntime;
+                        large += proc.memSize > MEM_MAX_SIZE / 4;
+                }
+                fclose(fp);
+        }
+        else
+        {
+                FILE *fp = fopen(fileName, "w");
+                if (fp == NULL)
+                {
+                        perror("workload_gen: couldn't create the trace");
+                        exit(EXIT_FAILURE);
+                }
+
+                fprintf(fp, "#id arrival runtime priority memorysize\n");
+                work.state = work.seed, work.time = 0, work.burstLeft = 0;
+                for (long id = 1; id <= work.count; id++)
+                {
+                        Generate(&work, &proc, id);
+                        fprintf(fp, "%d\t%d\t%d\t%d\t%d\n", proc.id, proc.arrivalTime, proc.runTime, proc.priority, proc.memSize);
+                        totalRuntime += proc.runTime;
+                        maxRuntime = proc.runTime > maxRuntime ? proc.runTime : maxRuntime;
+                        large += proc.memSize > MEM_MAX_SIZE / 4;
+                }
+                fclose(fp);
+        }
+
+        printf("workload_gen: %ld processes to %s, last arrival %d, runtime avg %.2f max %d, %.1f%% above %d bytes\n",
+               work.count, fileName, proc.arrivalTime, (double)totalRuntime / work.count, maxRuntime,
+               100.0 * large / work.count, MEM_MAX_SIZE / 4);
+}
+
+void Usage(const char *program)
+{
+        fprintf(stderr, "usage: %s -n count [-s seed] [-a arrivals] [-r runtimes] [-m memory]\n"
+                        "       [-c correlation] [-p max priority] [-R runtime cap] [-b] [-o file]\n"
+                        "  -a poisson:RATE | bursty:RATE,SIZE | uniform:MAXGAP   (poisson:0.5)\n"
+                        "     RATE processes (bursts for bursty) a tick, bursts of SIZE processes on average\n"
+                        "  -r pareto:MIN,ALPHA | lognormal:MU,SIGMA | uniform:MIN,MAX   (pareto:2,1.5)\n"
+                        "  -m bimodal:SMALL,LARGE,P | uniform:MIN,MAX   (bimodal:32,512,0.1)\n"
+                        "     up to SMALL bytes, or SMALL to LARGE bytes with probability P, at most %d\n"
+                        "  -c the correlation of the priority with the runtime, -1 to 1   (0)\n"
+                        "  -b writes the binary format, see trace_convert.c\n",
+                program, MEM_MAX_SIZE);
+        exit(EXIT_FAILURE);
+}
+
+/**
+ * @brief Parse a distribution given as name:p1,p2,p3
+ */
+void ParseDistribution(const char *spec, struct Distribution *dist)
+{
+        const char *colon = strchr(spec, ':');
+        size_t nameLength = colon ? (size_t)(colon - spec) : strlen(spec);
+        if (nameLength >= sizeof(dist->name))
+                nameLength = sizeof(dist->name) - 1;
+        memcpy(dist->name, spec, nameLength);
+        dist->name[nameLength] = '\0';
+
+        dist->nparams = 0;
+        for (const char *p = colon; p != NULL && dist->nparams < WORKLOAD_MAX_PARAMS; p = strchr(p + 1, ','))
+                dist->params[dist->nparams++] = atof(p + 1);
+}
+
+/**
+ * @brief Exit unless the distribution is one of kinds with its number of parameters
+ */
+void CheckDistribution(const char *option, const struct Distribution *dist, const struct DistributionKind *kinds)
+{
+        for (int i = 0; kinds[i].name != NULL; i++)
+        {
+                if (strcmp(dist->name, kinds[i].name) != 0)
+                        continue;
+                if (dist->nparams == kinds[i].nparams)
+                        return;
+
+                fprintf(stderr, "workload_gen: %s: %s takes %d parameters\n", option, dist->name, kinds[i].nparams);
+                exit(EXIT_FAILURE);
+        }
+        fprintf(stderr, "workload_gen: %s: unknown distribution %s\n", option, dist->name);
+        exit(EXIT_FAILURE);
+}
+
+/**
+ * @brief splitmix64, a small generator that's the same everywhere, unlike rand()
+ *
+ * @return double uniform in (0, 1)
+ */
+double Uniform(struct Workload *work)
+{
+        unsigned long long z = (work->state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z ^= z >> 31;
+        return ((z >> 11) + 0.5) / 9007199254740992.0;
+}
+
+/**
+ * @brief A standard normal draw (Box-Muller)
+ */
+double Normal(struct Workload *work)
+{
+        double u = Uniform(work), v = Uniform(work);
+        return sqrt(-2 * log(u)) * cos(2 * M_PI * v);
+}
+
+/**
+ * @brief The standard normal CDF
+ */
+double Phi(double z)
+{
+        return 0.5 * erfc(-z / M_SQRT2);
+}
+
+/**
+ * @brief The tick the next process arrives at
+ */
+int NextArrival(struct Workload *work)
+{
+        const double *p = work->arrival.params;
+
+        if (strcmp(work->arrival.name, "uniform") == 0)
+                work->time += floor(Uniform(work) * (p[0] + 1));
+        else if (strcmp(work->arrival.name, "poisson") == 0)
+                work->time += -log(Uniform(work)) / p[0];
+        else if (work->burstLeft > 0)
+                work->burstLeft--;
+        else
+        {
+                // the bursts arrive like a Poisson process, their sizes are geometric
+                work->time += -log(Uniform(work)) / p[0];
+                work->burstLeft = (int)floor(log(Uniform(work)) / log(1 - 1 / (p[1] > 1 ? p[1] : 1.000001)));
+        }
+        return work->time < INT32_MAX ? (int)work->time : INT32_MAX;
+}
+
+/**
+ * @brief A runtime at the quantile of z, a standard normal draw, so the
+ * priority can be drawn from the same z
+ */
+int Runtime(struct Workload *work, double z)
+{
+        const double *p = work->runtime.params;
+        double runtime;
+
+        if (strcmp(work->runtime.name, "lognormal") == 0)
+                runtime = exp(p[0] + p[1] * z);
+        else if (strcmp(work->runtime.name, "pareto") == 0)
+                runtime = p[0] * pow(1 - Phi(z), -1 / p[1]);
+        else
+                runtime = p[0] + floor(Phi(z) * (p[1] - p[0] + 1));
+
+        if (!(runtime < work->runtimeCap))
+                return work->runtimeCap;
+        return runtime < 1 ? 1 : (int)ceil(runtime);
+}
+
+/**
+ * @brief A memory size between 1 and MEM_MAX_SIZE
+ */
+int MemorySize(struct Workload *work)
+{
+        const double *p = work->memory.params;
+        double lo = p[0], hi = p[1];
+
+        if (strcmp(work->memory.name, "bimodal") == 0)
+        {
+                if (Uniform(work) < p[2])
+                        lo = p[0] + 1;
+                else
+                        lo = 1, hi = p[0];
+        }
+
+        int size = (int)(lo + floor(Uniform(work) * (hi - lo + 1)));
+        return size < 1 ? 1 : size > MEM_MAX_SIZE ? MEM_MAX_SIZE : size;
+}
+
+/**
+ * @brief Generate the next process. The priority and the runtime share a
+ * gaussian copula: with a positive correlation the long processes tend to get
+ * the high priority numbers, which is the low priority.
+ */
+void Generate(struct Workload *work, process_t *proc, long id)
+{
+        double z = Normal(work);
+        double zPriority = work->correlation * z + sqrt(1 - work->correlation * work->correlation) * Normal(work);
+
+        memset(proc, 0, sizeof(process_t));
+        proc->id = proc->task = (int)id;
+        proc->arrivalTime = NextArrival(work);
+        proc->runTime = Runtime(work, z);
+        proc->priority = (int)floor(Phi(zPriority) * (work->maxPriority + 1));
+        if (proc->priority > work->maxPriority)
+                proc->priority = work->maxPriority;
+        proc->memSize = MemorySize(work);
+}